@@ -75,6 +75,28 @@ struct LazySegmentTree {
         return M::op(sml, smr);
     }
 
+    ///  # push_all()
+    ///  遅延している作用を全て葉まで下ろす
+    ///  この後 apply を挟まずに prod を何度も呼ぶなら, prod_pushed の方が速い
+    ///  O(n)
+    void push_all() {
+        for (int i = 1; i < size_; i++) push(i);
+    }
+
+    ///  # prod_pushed(l, r)
+    ///  prod(l, r) と同じだが, 遅延を下ろさない
+    ///  push_all() の後, apply を挟まずに呼ぶこと
+    ///  O(logn)
+    T prod_pushed(int l, int r) const {
+        assert(0 <= l && l <= r && r <= n_);
+        T sml = M::e(), smr = M::e();
+        for (l += size_, r += size_; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) sml = M::op(sml, data_[l++]);
+            if (r & 1) smr = M::op(data_[--r], smr);
+        }
+        return M::op(sml, smr);
+    }
+
     ///  # all_prod()
     ///  O(1)
     T all_prod() {
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "./base.hpp"
+#include "./dijkstra.hpp"
+
+namespace nono {
+
+///  # astar(graph, source, target, heuristic)
+///  二点間負辺なしの最短経路問題
+///  heuristic(v) := vからtargetまでの距離の下界
+///  heuristicはconsistent (h(u) <= w(u, v) + h(v), h(target) = 0) でないと壊れる
+///  heuristic = 0 ならdijkstraと同じ
+///  O((V + E) log (V + E)), 実際にはheuristicが良いほど探索する頂点が減る
+template <class T, class F>
+internal::PointToPointResult<T> astar(const Graph<T>& graph, int source, int target, const F& heuristic) {
+    using Result = internal::PointToPointResult<T>;
+    assert(0 <= source && source < graph.size());
+    assert(0 <= target && target < graph.size());
+    constexpr int NONE = -1;
+
+    int n = graph.size();
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    std::vector<bool> done(n);
+    //  (dist + heuristic, vertex)
+    std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>, std::greater<std::pair<T, int>>> que;
+    dist[source] = 0;
+    que.emplace(heuristic(source), source);
+
+    int settled = 0;
+    while (!que.empty()) {
+        int u = que.top().second;
+        que.pop();
+        if (done[u]) continue;
+        done[u] = true;
+        settled++;
+        if (u == target) break;
+        for (const auto& e: graph[u]) {
+            if (dist[e.to] > dist[u] + e.weight) {
+                assert(!done[e.to]);
+                dist[e.to] = dist[u] + e.weight;
+                parent[e.to] = u;
+                que.emplace(dist[e.to] + heuristic(e.to), e.to);
+            }
+        }
+    }
+
+    if (!done[target]) {
+        return Result(Result::UNREACHABLE, {}, settled);
+    }
+    std::vector<int> path;
+    for (int pos = target; pos != NONE; pos = parent[pos]) {
+        path.push_back(pos);
+    }
+    std::reverse(path.begin(), path.end());
+    return Result(dist[target], std::move(path), settled);
+}
+
+}  //  namespace nono
@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <utility>
 #include <vector>
 
+#include "../ds/csr-array.hpp"
+#include "../utility/parallel.hpp"
 #include "./base.hpp"
 
 namespace nono {
@@ -81,14 +84,99 @@ class BellmanFordResult {
 
 }  //  namespace internal
 
-///  # BellmanFord(edges, source)
+namespace internal {
+
+///  # parallel bellman ford(n, edges, source, threads)
+///  各ラウンドで前のラウンドの距離だけを見て全頂点を同時に緩和する
+///  入ってくる辺を頂点ごとにCSRでまとめ, 頂点をthreads個に分けて並列に緩和する
+///  各スレッドは自分の頂点にしか書き込まないので, 結果はスレッド数によらない
+///  負閉路から到達できる頂点は, ラウンド後にまだ緩和できる頂点からの探索で求める
+///  O(nm / threads + n + m)
+template <class T>
+BellmanFordResult<T> parallel_bellman_ford(int n, const std::vector<EdgeBase<T>>& edges,
+                                           const std::vector<int>& source, int threads) {
+    using Result = BellmanFordResult<T>;
+    std::vector<std::pair<int, std::pair<int, T>>> incoming, outgoing;
+    incoming.reserve(edges.size());
+    outgoing.reserve(edges.size());
+    for (const auto& e: edges) {
+        assert(0 <= e.from && e.from < n);
+        assert(0 <= e.to && e.to < n);
+        incoming.push_back({e.to, {e.from, e.weight}});
+        outgoing.push_back({e.from, {e.to, e.weight}});
+    }
+    const CSRArray<std::pair<int, T>> reverse_graph(n, incoming);
+    const CSRArray<std::pair<int, T>> graph(n, outgoing);
+
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, -1);
+    for (auto s: source) {
+        assert(0 <= s && s < n);
+        dist[s] = 0;
+    }
+    std::vector<T> next = dist;
+    //  changed[id] := スレッドidの頂点が更新されたか
+    std::vector<char> changed(threads);
+
+    auto relax = [&](int id, int left, int right) {
+        changed[id] = false;
+        for (int v = left; v < right; v++) {
+            T best = dist[v];
+            for (auto [u, w]: reverse_graph[v]) {
+                if (dist[u] == Result::UNREACHABLE) continue;
+                if (best == Result::UNREACHABLE || dist[u] + w < best) {
+                    best = dist[u] + w;
+                    parent[v] = u;
+                }
+            }
+            next[v] = best;
+            changed[id] |= best != dist[v];
+        }
+    };
+    for (int i = 0; i + 1 < n; i++) {
+        internal::parallel_for(n, threads, relax);
+        std::swap(dist, next);
+        if (std::find(changed.begin(), changed.end(), true) == changed.end()) break;
+    }
+    //  まだ緩和できる頂点から到達できる頂点がINVALID
+    internal::parallel_for(n, threads, relax);
+    std::vector<int> stack;
+    std::vector<bool> invalid(n);
+    for (int v = 0; v < n; v++) {
+        if (next[v] != dist[v]) {
+            invalid[v] = true;
+            stack.push_back(v);
+        }
+    }
+    bool has_negative_cycle = !stack.empty();
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        dist[u] = Result::INVALID;
+        for (auto [v, w]: graph[u]) {
+            if (!invalid[v]) {
+                invalid[v] = true;
+                stack.push_back(v);
+            }
+        }
+    }
+
+    return Result(std::move(dist), std::move(parent), has_negative_cycle);
+}
+
+}  //  namespace internal
+
+///  # BellmanFord(edges, source, threads)
 ///  複数始点負辺ありの単一始点最短経路問題
+///  threads > 1 なら, ラウンドごとに全頂点を並列に緩和する (密なグラフ向け)
 ///  O(nm)
 template <class T>
 internal::BellmanFordResult<T> bellman_ford(int n, const std::vector<EdgeBase<T>>& edges,
-                                            const std::vector<int>& source) {
+                                            const std::vector<int>& source, int threads = 1) {
     using Result = internal::BellmanFordResult<T>;
     constexpr T INF = std::numeric_limits<T>::max();
+    assert(threads >= 1);
+    if (threads > 1) return internal::parallel_bellman_ford(n, edges, source, threads);
     std::vector<T> dist(n, Result::UNREACHABLE);
     std::vector<int> parent(n, -1);
     for (auto s: source) {
@@ -125,12 +213,13 @@ internal::BellmanFordResult<T> bellman_ford(int n, const std::vector<EdgeBase<T>
     return Result(std::move(dist), std::move(parent), has_negative_cycle);
 }
 
-///  # BellmanFord(edges, source)
+///  # BellmanFord(edges, source, threads)
 ///  単一始点負辺ありの単一始点最短経路問題
 ///  O(nm)
 template <class T>
-internal::BellmanFordResult<T> bellman_ford(int n, const std::vector<EdgeBase<T>>& edges, int source) {
-    return bellman_ford(n, edges, std::vector<int>{source});
+internal::BellmanFordResult<T> bellman_ford(int n, const std::vector<EdgeBase<T>>& edges, int source,
+                                            int threads = 1) {
+    return bellman_ford(n, edges, std::vector<int>{source}, threads);
 }
 
 }  //  namespace nono
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "./base.hpp"
+#include "./dijkstra.hpp"
+
+namespace nono {
+
+///  # bidirectional dijkstra(graph, reverse graph, source, target)
+///  二点間負辺なしの最短経路問題
+///  sourceからgraphを, targetからreverse graphを交互に探索する
+///  無向グラフならreverse graphにgraphを渡せば良い
+///  O((V + E) log (V + E)), 実際にはsource, targetの周りだけ探索する
+template <class T>
+internal::PointToPointResult<T> bidirectional_dijkstra(const Graph<T>& graph, const Graph<T>& reverse_graph,
+                                                       int source, int target) {
+    using Result = internal::PointToPointResult<T>;
+    using Heap = std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>, std::greater<std::pair<T, int>>>;
+    assert(graph.size() == reverse_graph.size());
+    assert(0 <= source && source < graph.size());
+    assert(0 <= target && target < graph.size());
+    constexpr int NONE = -1;
+
+    int n = graph.size();
+    //  0: forward (source -> v), 1: backward (v -> target)
+    std::vector<T> dist[2] = {std::vector<T>(n, Result::UNREACHABLE), std::vector<T>(n, Result::UNREACHABLE)};
+    std::vector<int> parent[2] = {std::vector<int>(n, NONE), std::vector<int>(n, NONE)};
+    std::vector<bool> done[2] = {std::vector<bool>(n), std::vector<bool>(n)};
+    Heap que[2];
+    const Graph<T>* graphs[2] = {&graph, &reverse_graph};
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    que[0].emplace(0, source);
+    que[1].emplace(0, target);
+
+    T best = Result::UNREACHABLE;
+    int meet = NONE;
+    int settled = 0;
+    if (source == target) {
+        best = 0;
+        meet = source;
+    }
+
+    while (!que[0].empty() && !que[1].empty()) {
+        //  どちらの先頭も best 以上なら, これ以上良い経路は存在しない
+        if (best != Result::UNREACHABLE && que[0].top().first + que[1].top().first >= best) break;
+        //  小さい方のヒープを進める
+        int side = (que[0].size() <= que[1].size() ? 0 : 1);
+        auto [d, u] = que[side].top();
+        que[side].pop();
+        if (done[side][u]) continue;
+        done[side][u] = true;
+        settled++;
+        for (const auto& e: (*graphs[side])[u]) {
+            if (dist[side][e.to] > d + e.weight) {
+                dist[side][e.to] = d + e.weight;
+                parent[side][e.to] = u;
+                que[side].emplace(dist[side][e.to], e.to);
+            }
+            if (dist[side ^ 1][e.to] != Result::UNREACHABLE && dist[side][e.to] + dist[side ^ 1][e.to] < best) {
+                best = dist[side][e.to] + dist[side ^ 1][e.to];
+                meet = e.to;
+            }
+        }
+    }
+
+    if (meet == NONE) {
+        return Result(Result::UNREACHABLE, {}, settled);
+    }
+    std::vector<int> path;
+    for (int pos = meet; pos != NONE; pos = parent[0][pos]) {
+        path.push_back(pos);
+    }
+    std::reverse(path.begin(), path.end());
+    for (int pos = parent[1][meet]; pos != NONE; pos = parent[1][pos]) {
+        path.push_back(pos);
+    }
+    assert(path.front() == source && path.back() == target);
+    return Result(best, std::move(path), settled);
+}
+
+}  //  namespace nono
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -13,81 +12,258 @@
 
 namespace nono {
 
-///  # bipatite matching(left, right, edges)
-///  L := left vertex (0 <= v < left)
-///  R := right vertex (0 <= v < right)
-///  E := (u, v) in (L, R) (= edges)
-///  return matching (L, R, E)
-///  辺番号列を返す
-///  多重辺あっても大丈夫なはず
-std::vector<int> bipartite_matching(int left, int right, std::vector<std::pair<int, int>> edges) {
-    int m = edges.size();
-    for (auto& [u, v]: edges) {
-        assert(0 <= u && u < left);
-        assert(0 <= v && v < right);
-        v += left;
+///  # BipartiteMatcher
+///  二部グラフの最大マッチング (Hopcroft-Karp)
+///  L := left vertex (0 <= u < left), R := right vertex (0 <= v < right)
+///  初期解をKarp-Sipserの貪欲で作り, 増加路は非再帰のdfsで探す
+///  辺を追加してからsolve()を呼ぶと, 今のマッチングから続けて増加させる
+///  多重辺あっても大丈夫
+class BipartiteMatcher {
+  public:
+    BipartiteMatcher(): BipartiteMatcher(0, 0) {}
+    BipartiteMatcher(int left, int right)
+        : left_(left),
+          right_(right),
+          mate_left_(left, NONE),
+          mate_right_(right, NONE),
+          mate_edge_(left, NONE) {}
+    BipartiteMatcher(int left, int right, const std::vector<std::pair<int, int>>& edges)
+        : BipartiteMatcher(left, right) {
+        edges_.reserve(edges.size());
+        for (auto [u, v]: edges) add_edge(u, v);
     }
-    const CSRArray graph(left, edges);
-    const int inf = std::numeric_limits<int>::max();
-    std::vector<int> adj(left + right, -1);
-    std::vector<int> dist(left + right, inf);
-    std::queue<int> que;
-    while (true) {
-        //  free頂点からbfsして距離を求める
-        std::fill(dist.begin(), dist.end(), inf);
-        for (int i = 0; i < left; i++) {
-            if (adj[i] == -1) {
-                dist[i] = 0;
-                que.push(i);
-            }
+
+    ///  # add_edge(u, v)
+    ///  L の u と R の v を結ぶ辺を追加して辺番号を返す
+    ///  O(1) (次のsolve()でO(V + E)かけてグラフを作り直す)
+    int add_edge(int u, int v) {
+        assert(0 <= u && u < left_);
+        assert(0 <= v && v < right_);
+        built_ = false;
+        edges_.emplace_back(u, v);
+        return edges_.size() - 1;
+    }
+
+    ///  # solve()
+    ///  最大マッチングの大きさを返す
+    ///  前回のマッチングを初期解にして, 増加路がなくなるまで増やす
+    ///  O(E sqrt(V))
+    int solve() {
+        build();
+        greedy();
+        augment();
+        return size_;
+    }
+
+    ///  # size()
+    ///  今のマッチングの大きさ
+    int size() const {
+        return size_;
+    }
+
+    ///  # mate_left(u)
+    ///  L の u とマッチしている R の頂点. なければ -1
+    int mate_left(int u) const {
+        assert(0 <= u && u < left_);
+        return mate_left_[u];
+    }
+
+    ///  # mate_right(v)
+    ///  R の v とマッチしている L の頂点. なければ -1
+    int mate_right(int v) const {
+        assert(0 <= v && v < right_);
+        return mate_right_[v];
+    }
+
+    ///  # matching()
+    ///  マッチングに使う辺番号 (昇順)
+    ///  O(V log V)
+    std::vector<int> matching() const {
+        std::vector<int> result;
+        result.reserve(size_);
+        for (int u = 0; u < left_; u++) {
+            if (mate_edge_[u] != NONE) result.push_back(mate_edge_[u]);
         }
-        while (!que.empty()) {
-            int u = que.front();
-            que.pop();
-            for (auto v: graph[u]) {
-                if (dist[v] == inf && adj[u] != v) {
-                    dist[v] = dist[u] + 1;
-                    if (adj[v] != -1) {
-                        dist[adj[v]] = dist[v] + 1;
-                        que.push(adj[v]);
-                    }
-                }
-            }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+  private:
+    static constexpr int NONE = -1;
+    int left_;
+    int right_;
+    int size_ = 0;
+    bool built_ = false;
+    std::vector<std::pair<int, int>> edges_;
+    //  [u] := (v, 辺番号)
+    CSRArray<std::pair<int, int>> graph_;
+    //  [v] := (u, 辺番号)
+    CSRArray<std::pair<int, int>> reverse_graph_;
+    std::vector<int> mate_left_;
+    std::vector<int> mate_right_;
+    std::vector<int> mate_edge_;
+
+    void build() {
+        if (built_) return;
+        int m = edges_.size();
+        std::vector<std::pair<int, std::pair<int, int>>> forward(m), backward(m);
+        for (int i = 0; i < m; i++) {
+            auto [u, v] = edges_[i];
+            forward[i] = {u, {v, i}};
+            backward[i] = {v, {u, i}};
+        }
+        graph_ = CSRArray<std::pair<int, int>>(left_, forward);
+        reverse_graph_ = CSRArray<std::pair<int, int>>(right_, backward);
+        built_ = true;
+    }
+
+    void match(int u, int v, int id) {
+        mate_left_[u] = v;
+        mate_right_[v] = u;
+        mate_edge_[u] = id;
+    }
+
+    //  Karp-Sipser: 空いている頂点だけのグラフで, 次数1の頂点があればその辺を, なければ適当な辺を採用する
+    //  頂点番号は L を [0, left), R を [left, left + right) とする
+    void greedy() {
+        int n = left_ + right_;
+        std::vector<int> degree(n);
+        std::vector<char> removed(n);
+        for (int u = 0; u < left_; u++) removed[u] = mate_left_[u] != NONE;
+        for (int v = 0; v < right_; v++) removed[left_ + v] = mate_right_[v] != NONE;
+        for (auto [u, v]: edges_) {
+            if (removed[u] || removed[left_ + v]) continue;
+            degree[u]++;
+            degree[left_ + v]++;
         }
-        bool reached = false;
-        for (int i = left; i < left + right; i++) {
-            reached |= dist[i] != inf && adj[i] == -1;
+        std::vector<int> stack;
+        for (int x = 0; x < n; x++) {
+            if (degree[x] == 1) stack.push_back(x);
         }
-        if (!reached) break;
-        auto dfs = [&](auto&& self, int u) -> bool {
-            assert(u < left);
-            for (auto v: graph[u]) {
-                if (dist[u] + 1 == dist[v]) {
-                    dist[v] = inf;
-                    if (adj[v] == -1 || self(self, adj[v])) {
-                        adj[u] = v;
-                        adj[v] = u;
-                        return true;
-                    }
+        auto neighbors = [&](int x) {
+            return x < left_ ? graph_[x] : reverse_graph_[x - left_];
+        };
+        auto other = [&](int x, int y) {
+            return x < left_ ? left_ + y : y;
+        };
+        auto remove = [&](int x) {
+            removed[x] = true;
+            for (auto [y, id]: neighbors(x)) {
+                int z = other(x, y);
+                if (removed[z]) continue;
+                if (--degree[z] == 1) stack.push_back(z);
+            }
+        };
+        //  xと残っている隣接頂点を結ぶ
+        auto take = [&](int x) {
+            for (auto [y, id]: neighbors(x)) {
+                int z = other(x, y);
+                if (removed[z]) continue;
+                if (x < left_) {
+                    match(x, y, id);
+                } else {
+                    match(y, x - left_, id);
                 }
+                size_++;
+                remove(x);
+                remove(z);
+                return;
             }
-            return false;
         };
-        for (int i = 0; i < left; i++) {
-            if (adj[i] == -1) {
-                dfs(dfs, i);
+        auto drain = [&]() {
+            while (!stack.empty()) {
+                int x = stack.back();
+                stack.pop_back();
+                if (!removed[x] && degree[x] == 1) take(x);
             }
+        };
+        for (int u = 0; u < left_; u++) {
+            drain();
+            if (!removed[u] && degree[u] > 0) take(u);
         }
+        drain();
     }
-    std::vector<int> result;
-    for (int i = 0; i < m; i++) {
-        auto [u, v] = edges[i];
-        if (adj[u] == v) {
-            result.push_back(i);
-            adj[u] = -1;
+
+    //  Hopcroft-Karp. 空いている L からbfsで層に分け, 非再帰のdfsで増加路を探す
+    void augment() {
+        const int inf = std::numeric_limits<int>::max();
+        std::vector<int> dist(left_);
+        std::vector<int> queue(left_);
+        std::vector<int> iter(left_);
+        std::vector<int> stack;
+        while (true) {
+            int head = 0, tail = 0;
+            for (int u = 0; u < left_; u++) {
+                if (mate_left_[u] == NONE) {
+                    dist[u] = 0;
+                    queue[tail++] = u;
+                } else {
+                    dist[u] = inf;
+                }
+            }
+            bool reached = false;
+            while (head < tail) {
+                int u = queue[head++];
+                for (auto [v, id]: graph_[u]) {
+                    int w = mate_right_[v];
+                    if (w == NONE) {
+                        reached = true;
+                    } else if (dist[w] == inf) {
+                        dist[w] = dist[u] + 1;
+                        queue[tail++] = w;
+                    }
+                }
+            }
+            if (!reached) break;
+
+            for (int u = 0; u < left_; u++) iter[u] = 0;
+            for (int root = 0; root < left_; root++) {
+                if (mate_left_[root] != NONE) continue;
+                stack.assign(1, root);
+                while (!stack.empty()) {
+                    int u = stack.back();
+                    auto adj = graph_[u];
+                    if (iter[u] == std::ssize(adj)) {
+                        //  行き止まり
+                        dist[u] = inf;
+                        stack.pop_back();
+                        continue;
+                    }
+                    auto [v, id] = adj[iter[u]];
+                    int w = mate_right_[v];
+                    if (w == NONE) {
+                        //  stackに沿って付け替える
+                        for (int i = std::ssize(stack) - 1; i >= 0; i--) {
+                            int x = stack[i];
+                            auto [y, e] = graph_[x][iter[x]];
+                            match(x, y, e);
+                        }
+                        size_++;
+                        for (int x: stack) dist[x] = inf;
+                        break;
+                    }
+                    if (dist[w] == dist[u] + 1) {
+                        stack.push_back(w);
+                    } else {
+                        iter[u]++;
+                    }
+                }
+            }
         }
     }
-    return result;
+};
+
+///  # bipatite matching(left, right, edges)
+///  L := left vertex (0 <= v < left)
+///  R := right vertex (0 <= v < right)
+///  E := (u, v) in (L, R) (= edges)
+///  return matching (L, R, E)
+///  辺番号列を返す
+///  多重辺あっても大丈夫なはず
+std::vector<int> bipartite_matching(int left, int right, const std::vector<std::pair<int, int>>& edges) {
+    BipartiteMatcher matcher(left, right, edges);
+    matcher.solve();
+    return matcher.matching();
 }
 
 ///  # bipatite matching(graph)
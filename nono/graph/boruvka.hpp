@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "../ds/union-find.hpp"
+#include "../utility/parallel.hpp"
+#include "./base.hpp"
+#include "./kruskal.hpp"
+
+namespace nono {
+
+///  # boruvka(n, edges, threads)
+///  最小全域森のコスト、使用する辺を取得する
+///  非連結でも良い (最小全域森を返す)
+///  各成分から出る最小の辺を全部同時に採用して縮約する, を繰り返す
+///  重みが同じ辺は辺番号で比較するので閉路はできない
+///
+///  threads > 1 なら辺をthreads個に分割し, 各成分の最小辺探索と
+///  成分内に閉じた辺の削除を複数スレッドで行う
+///  O(m log n)
+template <class T>
+internal::KruskalResult<T> boruvka(int n, const std::vector<EdgeBase<T>>& edges, int threads = 1) {
+    using Result = internal::KruskalResult<T>;
+    assert(threads >= 1);
+    constexpr int NONE = -1;
+
+    int m = edges.size();
+    T cost = 0;
+    std::vector<int> used_edge_id;
+    used_edge_id.reserve(std::max(n - 1, 0));
+    UnionFind uf(n);
+    std::vector<int> component(n);
+
+    //  スレッドごとに担当する辺, 各成分の最小辺
+    std::vector<std::vector<int>> chunks(threads);
+    std::vector<std::vector<int>> best(threads, std::vector<int>(n, NONE));
+    for (int id = 0; id < threads; id++) {
+        int left = (long long)m * id / threads;
+        int right = (long long)m * (id + 1) / threads;
+        chunks[id].reserve(right - left);
+        for (int i = left; i < right; i++) {
+            assert(0 <= edges[i].from && edges[i].from < n);
+            assert(0 <= edges[i].to && edges[i].to < n);
+            chunks[id].push_back(i);
+        }
+    }
+
+    auto lighter = [&edges](int lhs, int rhs) {
+        if (rhs == NONE) return true;
+        if (edges[lhs].weight != edges[rhs].weight) return edges[lhs].weight < edges[rhs].weight;
+        return lhs < rhs;
+    };
+    auto work = [&](int id) {
+        auto& chunk = chunks[id];
+        auto& out = best[id];
+        std::fill(out.begin(), out.end(), NONE);
+        int size = 0;
+        for (int i: chunk) {
+            int u = component[edges[i].from];
+            int v = component[edges[i].to];
+            if (u == v) continue;
+            chunk[size++] = i;
+            if (lighter(i, out[u])) out[u] = i;
+            if (lighter(i, out[v])) out[v] = i;
+        }
+        chunk.resize(size);
+    };
+
+    while (true) {
+        for (int v = 0; v < n; v++) component[v] = uf.leader(v);
+        internal::parallel_for(threads, threads, [&](int id, int, int) { work(id); });
+        bool updated = false;
+        for (int v = 0; v < n; v++) {
+            if (component[v] != v) continue;
+            int e = NONE;
+            for (int id = 0; id < threads; id++) {
+                if (best[id][v] != NONE && lighter(best[id][v], e)) e = best[id][v];
+            }
+            if (e == NONE) continue;
+            if (uf.merge(edges[e].from, edges[e].to)) {
+                cost += edges[e].weight;
+                used_edge_id.push_back(e);
+                updated = true;
+            }
+        }
+        if (!updated) break;
+    }
+
+    return Result(cost, used_edge_id);
+}
+
+///  # boruvka(graph, threads)
+///  graphは無向グラフ. 辺番号は graph を作ったときの辺の番号
+///  辺の列を復元してから boruvka(n, edges, threads) を呼ぶ
+///  O(m log n)
+template <class T>
+internal::KruskalResult<T> boruvka(const Graph<T>& graph, int threads = 1) {
+    assert(graph.is_undirected());
+    const int n = graph.size();
+    std::vector<EdgeBase<T>> edges(graph.edge_size());
+    for (int u = 0; u < n; u++) {
+        for (const auto& e: graph[u]) edges[e.id] = EdgeBase<T>(u, e.to, e.weight);
+    }
+    return boruvka(n, edges, threads);
+}
+
+}  //  namespace nono
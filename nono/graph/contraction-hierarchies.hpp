@@ -0,0 +1,564 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../ds/csr-array.hpp"
+#include "../utility/parallel.hpp"
+#include "./base.hpp"
+
+namespace nono {
+
+///  # Contraction Hierarchies
+///  同じ静的グラフに対して二点間最短経路クエリをたくさん投げるやつ
+///  負辺なし. 有向でも無向でも良い
+///
+///  前処理: 重要度の低い頂点から順に縮約し, 最短路が壊れるときだけshortcutを張る
+///  クエリ: sourceからは順位が上がる辺だけ, targetからは逆向きに順位が上がる辺だけを使う
+///          双方向dijkstraをする. 探索範囲はとても小さい
+///
+///  up graph, down graph はCSRで持つ
+///  operator<<, operator>> でファイルなどに書き出し, 読み込みができる
+///
+///  threads > 1 なら, 縮約していない頂点のうち隣接頂点より優先度が小さいもの (独立集合) を一度に縮約する
+///  witness search は集合の頂点を通らないようにして並列に行い, shortcut の追加は逐次
+///  集合の外の路だけを witness にするので, 集合をまとめて縮約しても最短路は壊れない
+///  結果はthreads (> 1) によらないが, threads = 1 (一頂点ずつ縮約する) とは階層が変わる
+template <class T>
+class ContractionHierarchies {
+    static constexpr int NONE = -1;
+
+    //  元の辺 or shortcut
+    //  shortcutならば from -> left.to (= middle) -> to
+    struct Arc {
+        int from;
+        int to;
+        T weight;
+        int left;
+        int right;
+    };
+
+    //  CSRの中身
+    struct Adj {
+        int to;
+        T weight;
+        int arc;
+    };
+
+  public:
+    static constexpr T UNREACHABLE = std::numeric_limits<T>::max();
+
+    ContractionHierarchies(): n_(0) {}
+
+    ///  # ContractionHierarchies(graph, settle limit, threads)
+    ///  witness search は settle limit 頂点で打ち切る (shortcut が増えるだけで正しさは変わらない)
+    ///  優先度の見積もりでは settle limit / 10 頂点で打ち切る
+    ///  O(たくさん), 道路っぽいグラフならだいたい線形
+    ContractionHierarchies(const Graph<T>& graph, int settle_limit = 500, int threads = 1): n_(graph.size()) {
+        assert(threads >= 1);
+        Builder builder(graph, settle_limit, threads);
+        arcs_ = std::move(builder.arcs);
+        build(std::move(builder.up_arcs), std::move(builder.down_arcs));
+    }
+
+    ///  # size()
+    ///  |V|
+    int size() const {
+        return n_;
+    }
+
+    ///  # arc_size()
+    ///  |E| + |shortcut|
+    int arc_size() const {
+        return arcs_.size();
+    }
+
+    ///  # dist(source, target)
+    ///  if source and target are not connected, return UNREACHABLE
+    ///  O(小さい)
+    T dist(int source, int target) {
+        assert(0 <= source && source < n_);
+        assert(0 <= target && target < n_);
+        return search(source, target).first;
+    }
+
+    ///  # path(source, target)
+    ///  return shortest path from source to target
+    ///  source -> ... -> ... -> target
+    ///  if we can not reach target, return empty vector
+    ///  O(小さい + |path|)
+    std::vector<int> path(int source, int target) {
+        assert(0 <= source && source < n_);
+        assert(0 <= target && target < n_);
+        auto [best, meet] = search(source, target);
+        if (best == UNREACHABLE) return {};
+        std::vector<int> forward, backward;
+        for (int pos = meet; parent_[0][pos] != NONE; pos = arcs_[parent_[0][pos]].from) {
+            forward.push_back(parent_[0][pos]);
+        }
+        for (int pos = meet; parent_[1][pos] != NONE; pos = arcs_[parent_[1][pos]].to) {
+            backward.push_back(parent_[1][pos]);
+        }
+        std::reverse(forward.begin(), forward.end());
+        std::vector<int> result{source};
+        for (auto arc: forward) unpack(arc, result);
+        for (auto arc: backward) unpack(arc, result);
+        assert(result.back() == target);
+        return result;
+    }
+
+    ///  浮動小数点数の重みも読み直して同じ値になる桁数で書く
+    friend std::ostream& operator<<(std::ostream& os, const ContractionHierarchies& ch) {
+        const auto flags = os.flags();
+        const auto precision = os.precision(std::numeric_limits<T>::max_digits10);
+        os.unsetf(std::ios::floatfield);
+        os << ch.n_ << ' ' << ch.arcs_.size() << '\n';
+        for (const auto& arc: ch.arcs_) {
+            os << arc.from << ' ' << arc.to << ' ' << arc.weight << ' ' << arc.left << ' ' << arc.right << '\n';
+        }
+        for (const auto& arcs: {ch.up_arcs_, ch.down_arcs_}) {
+            os << arcs.size() << '\n';
+            for (auto arc: arcs) os << arc << ' ';
+            os << '\n';
+        }
+        os.flags(flags);
+        os.precision(precision);
+        return os;
+    }
+
+    ///  読み込みに失敗したり中身が壊れていたら is に failbit を立て, ch は変えない
+    ///  shortcut は繋ぐ二本の辺より後ろにあり, from -> left.to = right.from -> to と繋がっていること
+    ///  m, k が大きすぎても, 実際に読めた分しか確保しない
+    friend std::istream& operator>>(std::istream& is, ContractionHierarchies& ch) {
+        //  これより大きい m, k は先に確保せず, 読みながら伸ばす
+        constexpr int RESERVE_LIMIT = 1 << 20;
+        auto fail = [&]() -> std::istream& {
+            is.setstate(std::ios::failbit);
+            return is;
+        };
+        int n, m;
+        if (!(is >> n >> m) || n < 0 || m < 0) return fail();
+        std::vector<Arc> arcs;
+        arcs.reserve(std::min(m, RESERVE_LIMIT));
+        for (int i = 0; i < m; i++) {
+            Arc arc;
+            if (!(is >> arc.from >> arc.to >> arc.weight >> arc.left >> arc.right)) return is;
+            if (arc.from < 0 || n <= arc.from || arc.to < 0 || n <= arc.to || !(arc.weight >= 0)) return fail();
+            if ((arc.left == NONE) != (arc.right == NONE)) return fail();
+            if (arc.left != NONE) {
+                if (arc.left < 0 || i <= arc.left || arc.right < 0 || i <= arc.right) return fail();
+                const auto& left = arcs[arc.left];
+                const auto& right = arcs[arc.right];
+                if (left.from != arc.from || left.to != right.from || right.to != arc.to) return fail();
+            }
+            arcs.push_back(arc);
+        }
+        std::vector<int> graph_arcs[2];
+        for (auto& a: graph_arcs) {
+            int k;
+            if (!(is >> k) || k < 0) return fail();
+            a.reserve(std::min(k, RESERVE_LIMIT));
+            for (int i = 0; i < k; i++) {
+                int arc;
+                if (!(is >> arc)) return is;
+                if (arc < 0 || m <= arc) return fail();
+                a.push_back(arc);
+            }
+        }
+        ch.n_ = n;
+        ch.arcs_ = std::move(arcs);
+        ch.build(std::move(graph_arcs[0]), std::move(graph_arcs[1]));
+        return is;
+    }
+
+  private:
+    //  縮約するやつ. 構築後は捨てる
+    struct Builder {
+        //  一頂点あたりの仕事 (witness search) が重いので, 小さい集合から並列にする
+        static constexpr int PARALLEL_THRESHOLD = 1 << 7;
+
+        //  shortcut (in arc, out arc, weight)
+        struct Shortcut {
+            int in_arc;
+            int out_arc;
+            T weight;
+        };
+
+        //  witness search の作業領域. スレッドごとに持つ
+        struct Scratch {
+            std::vector<bool> is_target;
+            std::vector<T> dist;
+            std::vector<int> touched;
+            std::vector<std::pair<T, int>> heap;
+        };
+
+        Builder(const Graph<T>& graph, int settle_limit, int threads)
+            : n(graph.size()),
+              settle_limit(settle_limit),
+              simulate_limit(std::max(1, settle_limit / 10)),
+              threads(threads),
+              out(n),
+              in(n),
+              contracted(n),
+              in_batch(n),
+              deleted_neighbors(n),
+              level(n),
+              current(n),
+              scratch(threads, Scratch{std::vector<bool>(n), std::vector<T>(n, UNREACHABLE), {}, {}}) {
+            //  多重辺は最小のものだけ, 自己ループは捨てる
+            std::vector<int> last(n, NONE);
+            for (int u = 0; u < n; u++) {
+                for (const auto& e: graph[u]) {
+                    assert(e.weight >= 0);
+                    if (e.to == u) continue;
+                    if (last[e.to] != NONE) {
+                        arcs[last[e.to]].weight = std::min(arcs[last[e.to]].weight, e.weight);
+                        continue;
+                    }
+                    last[e.to] = arcs.size();
+                    out[u].push_back(arcs.size());
+                    in[e.to].push_back(arcs.size());
+                    arcs.push_back({u, e.to, e.weight, NONE, NONE});
+                }
+                for (int id: out[u]) last[arcs[id].to] = NONE;
+            }
+            if (threads == 1) {
+                contract_one_by_one();
+            } else {
+                contract_in_batches();
+            }
+        }
+
+        //  優先度の一番小さい頂点から一つずつ縮約する
+        void contract_one_by_one() {
+            using P = std::pair<int, int>;
+            std::priority_queue<P, std::vector<P>, std::greater<P>> que;
+            for (int v = 0; v < n; v++) {
+                current[v] = priority(v, scratch[0]);
+                que.emplace(current[v], v);
+            }
+            std::vector<int> neighbors;
+            std::vector<Shortcut> added;
+            while (!que.empty()) {
+                auto [p, v] = que.top();
+                que.pop();
+                if (contracted[v] || current[v] != p) continue;
+                //  lazy update
+                current[v] = priority(v, scratch[0]);
+                if (!que.empty() && current[v] > que.top().first) {
+                    que.emplace(current[v], v);
+                    continue;
+                }
+                neighbors.clear();
+                for (int id: out[v]) neighbors.push_back(arcs[id].to);
+                for (int id: in[v]) neighbors.push_back(arcs[id].from);
+                added.clear();
+                shortcuts(v, [&](int in_arc, int out_arc, T weight) { added.push_back({in_arc, out_arc, weight}); },
+                          settle_limit, scratch[0]);
+                contract(v, added);
+                //  隣接頂点の優先度だけ更新する
+                std::ranges::sort(neighbors);
+                neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+                for (int u: neighbors) {
+                    current[u] = priority(u, scratch[0]);
+                    que.emplace(current[u], u);
+                }
+            }
+        }
+
+        //  (優先度, 番号) が隣接頂点のどれよりも小さい頂点をまとめて縮約する
+        //  優先度の計算と witness search は並列, 縮約は逐次
+        void contract_in_batches() {
+            std::vector<int> remaining(n), batch, neighbors;
+            for (int v = 0; v < n; v++) remaining[v] = v;
+            parallel_for(n, [&](int id, int v) { current[v] = priority(v, scratch[id]); });
+            std::vector<std::vector<Shortcut>> added;
+            std::vector<bool> is_neighbor(n);
+            while (!remaining.empty()) {
+                batch.clear();
+                for (int v: remaining) {
+                    auto smaller = [&](int u) {
+                        return std::pair(current[v], v) < std::pair(current[u], u);
+                    };
+                    if (std::ranges::all_of(out[v], [&](int id) { return smaller(arcs[id].to); }) &&
+                        std::ranges::all_of(in[v], [&](int id) { return smaller(arcs[id].from); })) {
+                        batch.push_back(v);
+                        in_batch[v] = true;
+                    }
+                }
+                //  集合の頂点どうしは隣接しないので, 各頂点の shortcut は独立に求まる
+                if ((int)added.size() < (int)batch.size()) added.resize(batch.size());
+                parallel_for(batch.size(), [&](int id, int j) {
+                    added[j].clear();
+                    shortcuts(
+                        batch[j],
+                        [&](int in_arc, int out_arc, T weight) { added[j].push_back({in_arc, out_arc, weight}); },
+                        settle_limit, scratch[id]);
+                });
+                neighbors.clear();
+                for (int j = 0; j < (int)batch.size(); j++) {
+                    const int v = batch[j];
+                    for (int id: out[v]) {
+                        if (!is_neighbor[arcs[id].to]) neighbors.push_back(arcs[id].to);
+                        is_neighbor[arcs[id].to] = true;
+                    }
+                    for (int id: in[v]) {
+                        if (!is_neighbor[arcs[id].from]) neighbors.push_back(arcs[id].from);
+                        is_neighbor[arcs[id].from] = true;
+                    }
+                    contract(v, added[j]);
+                    in_batch[v] = false;
+                }
+                //  隣接頂点の優先度だけ更新する
+                for (int u: neighbors) is_neighbor[u] = false;
+                parallel_for(neighbors.size(), [&](int id, int j) {
+                    current[neighbors[j]] = priority(neighbors[j], scratch[id]);
+                });
+                std::erase_if(remaining, [&](int v) { return contracted[v]; });
+            }
+        }
+
+        //  [0, size) を threads 個に分けて f(スレッド番号, i) を呼ぶ
+        template <class F>
+        void parallel_for(int size, const F& f) {
+            const int workers_size = size < PARALLEL_THRESHOLD ? 1 : threads;
+            internal::parallel_for(size, workers_size, [&](int id, int left, int right) {
+                for (int i = left; i < right; i++) f(id, i);
+            });
+        }
+
+        //  edge difference + 縮約済みの隣接頂点数 + 階層の深さ
+        int priority(int v, Scratch& scratch) const {
+            int count = 0;
+            shortcuts(v, [&](int, int, T) { count++; }, simulate_limit, scratch);
+            return 2 * (count - (int)in[v].size() - (int)out[v].size()) + deleted_neighbors[v] + level[v];
+        }
+
+        void contract(int v, const std::vector<Shortcut>& added) {
+            contracted[v] = true;
+            for (int id: out[v]) {
+                up_arcs.push_back(id);
+                erase(in[arcs[id].to], id);
+                deleted_neighbors[arcs[id].to]++;
+                level[arcs[id].to] = std::max(level[arcs[id].to], level[v] + 1);
+            }
+            for (int id: in[v]) {
+                down_arcs.push_back(id);
+                erase(out[arcs[id].from], id);
+                deleted_neighbors[arcs[id].from]++;
+                level[arcs[id].from] = std::max(level[arcs[id].from], level[v] + 1);
+            }
+            out[v].clear();
+            in[v].clear();
+            for (const auto& shortcut: added) {
+                add_shortcut(shortcut.in_arc, shortcut.out_arc, shortcut.weight);
+            }
+        }
+
+        //  u -> v -> w を置き換える shortcut を列挙する
+        //  f(in arc, out arc, weight)
+        template <class F>
+        void shortcuts(int v, const F& f, int limit_settled, Scratch& scratch) const {
+            if (out[v].empty()) return;
+            auto& [is_target, dist, touched, heap] = scratch;
+            T max_out = 0;
+            for (int id: out[v]) {
+                max_out = std::max(max_out, arcs[id].weight);
+                is_target[arcs[id].to] = true;
+            }
+            for (int in_arc: in[v]) {
+                int u = arcs[in_arc].from;
+                int targets = out[v].size() - (is_target[u] ? 1 : 0);
+                if (targets == 0) continue;
+                witness_search(u, v, arcs[in_arc].weight + max_out, targets, limit_settled, scratch);
+                for (int out_arc: out[v]) {
+                    int w = arcs[out_arc].to;
+                    if (w == u) continue;
+                    T weight = arcs[in_arc].weight + arcs[out_arc].weight;
+                    if (dist[w] > weight) f(in_arc, out_arc, weight);
+                }
+                for (int x: touched) dist[x] = UNREACHABLE;
+                touched.clear();
+            }
+            for (int id: out[v]) is_target[arcs[id].to] = false;
+        }
+
+        //  v と同時に縮約する頂点を通らない u からの最短距離 (limit以下だけ正確)
+        //  targets 個の target をすべて確定させたら打ち切る
+        void witness_search(int u, int v, T limit, int targets, int limit_settled, Scratch& scratch) const {
+            auto& [is_target, dist, touched, heap] = scratch;
+            //  heap の領域を使い回す
+            heap.clear();
+            dist[u] = 0;
+            touched.push_back(u);
+            heap.emplace_back(0, u);
+            int settled = 0;
+            while (!heap.empty() && settled < limit_settled) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                auto [d, x] = heap.back();
+                heap.pop_back();
+                if (dist[x] < d) continue;
+                if (d > limit) break;
+                if (is_target[x] && x != u && --targets == 0) break;
+                settled++;
+                for (int id: out[x]) {
+                    int y = arcs[id].to;
+                    if (y == v || in_batch[y]) continue;
+                    if (dist[y] > d + arcs[id].weight) {
+                        if (dist[y] == UNREACHABLE) touched.push_back(y);
+                        dist[y] = d + arcs[id].weight;
+                        heap.emplace_back(dist[y], y);
+                        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                    }
+                }
+            }
+        }
+
+        void add_shortcut(int in_arc, int out_arc, T weight) {
+            int u = arcs[in_arc].from;
+            int w = arcs[out_arc].to;
+            for (int& id: out[u]) {
+                if (arcs[id].to != w) continue;
+                if (arcs[id].weight <= weight) return;
+                //  既存の辺より短いので置き換える
+                int old = id;
+                id = arcs.size();
+                std::replace(in[w].begin(), in[w].end(), old, id);
+                arcs.push_back({u, w, weight, in_arc, out_arc});
+                return;
+            }
+            out[u].push_back(arcs.size());
+            in[w].push_back(arcs.size());
+            arcs.push_back({u, w, weight, in_arc, out_arc});
+        }
+
+        static void erase(std::vector<int>& list, int id) {
+            auto it = std::find(list.begin(), list.end(), id);
+            assert(it != list.end());
+            *it = list.back();
+            list.pop_back();
+        }
+
+        int n;
+        int settle_limit;
+        int simulate_limit;
+        int threads;
+        std::vector<Arc> arcs;
+        std::vector<std::vector<int>> out;
+        std::vector<std::vector<int>> in;
+        std::vector<bool> contracted;
+        //  同じ回に縮約する頂点. witness search で通らない
+        std::vector<bool> in_batch;
+        std::vector<int> deleted_neighbors;
+        std::vector<int> level;
+        //  優先度
+        std::vector<int> current;
+        std::vector<Scratch> scratch;
+        std::vector<int> up_arcs;
+        std::vector<int> down_arcs;
+    };
+
+    //  up: from -> to (rank from < rank to)
+    //  down: to -> from (rank to < rank from), backward search 用に逆向き
+    void build(std::vector<int> up_arcs, std::vector<int> down_arcs) {
+        up_arcs_ = std::move(up_arcs);
+        down_arcs_ = std::move(down_arcs);
+        std::vector<std::pair<int, Adj>> up, down;
+        up.reserve(up_arcs_.size());
+        down.reserve(down_arcs_.size());
+        for (int id: up_arcs_) up.emplace_back(arcs_[id].from, Adj{arcs_[id].to, arcs_[id].weight, id});
+        for (int id: down_arcs_) down.emplace_back(arcs_[id].to, Adj{arcs_[id].from, arcs_[id].weight, id});
+        graph_[0] = CSRArray<Adj>(n_, up);
+        graph_[1] = CSRArray<Adj>(n_, down);
+        for (int side = 0; side < 2; side++) {
+            dist_[side].assign(n_, UNREACHABLE);
+            parent_[side].assign(n_, NONE);
+        }
+    }
+
+    //  (dist, meet)
+    std::pair<T, int> search(int source, int target) {
+        for (int side = 0; side < 2; side++) {
+            for (int v: touched_[side]) {
+                dist_[side][v] = UNREACHABLE;
+                parent_[side][v] = NONE;
+            }
+            touched_[side].clear();
+            heap_[side].clear();
+        }
+        dist_[0][source] = 0;
+        dist_[1][target] = 0;
+        touched_[0].push_back(source);
+        touched_[1].push_back(target);
+        heap_[0].emplace_back(0, source);
+        heap_[1].emplace_back(0, target);
+        T best = UNREACHABLE;
+        int meet = NONE;
+        if (source == target) {
+            best = 0;
+            meet = source;
+        }
+        //  上向きにしか進まないので, 各方向とも best を超えたら打ち切れる
+        for (int side = 0; !heap_[0].empty() || !heap_[1].empty(); side ^= 1) {
+            auto& heap = heap_[side];
+            if (heap.empty()) continue;
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (d >= best) {
+                heap.clear();
+                continue;
+            }
+            if (dist_[side][u] < d) continue;
+            if (dist_[side ^ 1][u] != UNREACHABLE && d + dist_[side ^ 1][u] < best) {
+                best = d + dist_[side ^ 1][u];
+                meet = u;
+            }
+            for (const auto& e: graph_[side][u]) {
+                if (dist_[side][e.to] > d + e.weight) {
+                    if (dist_[side][e.to] == UNREACHABLE) touched_[side].push_back(e.to);
+                    dist_[side][e.to] = d + e.weight;
+                    parent_[side][e.to] = e.arc;
+                    heap.emplace_back(dist_[side][e.to], e.to);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                }
+            }
+        }
+        return {best, meet};
+    }
+
+    //  shortcut を元の辺に展開して, 終点を result に積む
+    void unpack(int arc, std::vector<int>& result) const {
+        std::vector<int> stack{arc};
+        while (!stack.empty()) {
+            int id = stack.back();
+            stack.pop_back();
+            if (arcs_[id].left == NONE) {
+                result.push_back(arcs_[id].to);
+            } else {
+                stack.push_back(arcs_[id].right);
+                stack.push_back(arcs_[id].left);
+            }
+        }
+    }
+
+    int n_;
+    std::vector<Arc> arcs_;
+    std::vector<int> up_arcs_;
+    std::vector<int> down_arcs_;
+    CSRArray<Adj> graph_[2];
+    //  クエリ用の作業領域. 触ったところだけ戻す
+    std::vector<T> dist_[2];
+    std::vector<int> parent_[2];
+    std::vector<int> touched_[2];
+    std::vector<std::pair<T, int>> heap_[2];
+};
+
+}  //  namespace nono
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../ds/csr-array.hpp"
+#include "../utility/parallel.hpp"
+#include "./base.hpp"
+#include "./dijkstra.hpp"
+#include "./topological-sort.hpp"
+
+namespace nono {
+
+namespace internal {
+
+///  # dag_path(graph, source, threads, better)
+///  DAGの複数始点最短路/最長路. betterで比べて良い方を取る
+///  topological_levels の段の順に, 各頂点が入ってくる辺から距離を集める
+///  同じ段の頂点は互いに独立なので, threads > 1 なら段を分割して並列に処理する
+///  親は最良のもののうち番号が最小の頂点
+///  O(V log V + E)
+template <class T, class Compare>
+DijkstraResult<T> dag_path(const Graph<T>& graph, const std::vector<int>& source, int threads, Compare better) {
+    using Result = DijkstraResult<T>;
+    assert(graph.is_directed());
+    assert(threads >= 1);
+    constexpr int NONE = -1;
+    //  これより小さい段は一人で処理する
+    constexpr int PARALLEL_THRESHOLD = 1 << 12;
+    const int n = graph.size();
+
+    const auto levels = topological_levels(graph, threads);
+    assert(n == 0 || !levels.empty());
+
+    //  入ってくる辺 (weight, from). 始点の番号順に並ぶ
+    std::vector<std::pair<int, std::pair<T, int>>> incoming;
+    incoming.reserve(graph.edge_size());
+    for (int u = 0; u < n; u++) {
+        for (const auto& e: graph[u]) incoming.push_back({e.to, {e.weight, u}});
+    }
+    const CSRArray<std::pair<T, int>> reverse_graph(n, incoming);
+
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    std::vector<bool> is_source(n);
+    for (int s: source) {
+        assert(0 <= s && s < n);
+        is_source[s] = true;
+    }
+
+    for (const auto& level: levels) {
+        const int size = level.size();
+        const int workers_size = size < PARALLEL_THRESHOLD ? 1 : threads;
+        internal::parallel_for(size, workers_size, [&](int, int left, int right) {
+            for (int i = left; i < right; i++) {
+                const int v = level[i];
+                T best = Result::UNREACHABLE;
+                int p = NONE;
+                if (is_source[v]) best = 0;
+                for (const auto& [w, u]: reverse_graph[v]) {
+                    if (dist[u] == Result::UNREACHABLE) continue;
+                    T d = dist[u] + w;
+                    if (best == Result::UNREACHABLE || better(d, best)) {
+                        best = d;
+                        p = u;
+                    }
+                }
+                dist[v] = best;
+                parent[v] = p;
+            }
+        });
+    }
+
+    return Result(std::move(dist), std::move(parent));
+}
+
+}  //  namespace internal
+
+///  # dag shortest path(graph, source, threads)
+///  DAGの複数始点最短経路問題. 負辺があってもよい
+///  graphはDAGであること
+///  O(V log V + E)
+template <class T>
+internal::DijkstraResult<T> dag_shortest_path(const Graph<T>& graph, const std::vector<int>& source,
+                                              int threads = 1) {
+    return internal::dag_path(graph, source, threads, std::less<T>());
+}
+
+///  # dag shortest path(graph, source, threads)
+///  単一始点
+///  O(V log V + E)
+template <class T>
+internal::DijkstraResult<T> dag_shortest_path(const Graph<T>& graph, int source, int threads = 1) {
+    return dag_shortest_path(graph, std::vector<int>{source}, threads);
+}
+
+///  # dag longest path(graph, source, threads)
+///  DAGの複数始点最長経路問題. 到達できない頂点は UNREACHABLE
+///  graphはDAGであること
+///  O(V log V + E)
+template <class T>
+internal::DijkstraResult<T> dag_longest_path(const Graph<T>& graph, const std::vector<int>& source, int threads = 1) {
+    return internal::dag_path(graph, source, threads, std::greater<T>());
+}
+
+///  # dag longest path(graph, source, threads)
+///  単一始点
+///  O(V log V + E)
+template <class T>
+internal::DijkstraResult<T> dag_longest_path(const Graph<T>& graph, int source, int threads = 1) {
+    return dag_longest_path(graph, std::vector<int>{source}, threads);
+}
+
+}  //  namespace nono
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <barrier>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "./base.hpp"
+#include "./dijkstra.hpp"
+
+namespace nono {
+
+///  # delta stepping(graph, source, delta, threads)
+///  複数始点負辺なしの最短経路問題
+///  距離を幅deltaのbucketに分け, 同じbucketの頂点はまとめて緩和する
+///  delta以下の辺(light edge)はbucketが空になるまで繰り返し, それより重い辺(heavy edge)は最後に一回だけ緩和する
+///
+///  threads > 1 なら頂点を番号で threads 個の区間に分け, id番のスレッドが区間内の頂点の dist, parent, bucket を持つ
+///  各段は (1) bucketから frontier を取り出す (2) frontier を等分して緩和要求を行き先の持ち主ごとに作る
+///  (3) 持ち主が自分宛ての要求を適用する の順で, スレッドは最後まで生かして段ごとに barrier で待ち合わせる
+///  要求の適用順はthreadsで決まるので結果は決定的. distはdijkstraと一致する
+///  delta = 最大辺重み なら dijkstra に近く, delta が小さいほど並列度が上がる
+///  bucketは最大 MAX_BUCKETS 個を巡回させ, それより先の頂点は持ち主ごとの overflow (heap) に置いて窓に入ったら移す
+///  空でないbucketの番号も heap で持ち, 空のbucketは飛ばすので 最大辺重み / delta が大きくてもよい
+///  O((V + E) log (V + E)) に加えて, 段の数 (空でないbucketごとに light edge の繰り返し回数 + 1) に比例する待ち合わせ
+template <class T>
+internal::DijkstraResult<T> delta_stepping(const Graph<T>& graph, const std::vector<int>& source, T delta,
+                                           int threads = 1) {
+    using Result = internal::DijkstraResult<T>;
+    //  (to, dist, from)
+    using Request = std::tuple<int, T, int>;
+    assert(delta > 0);
+    assert(threads >= 1);
+    constexpr int NONE = -1;
+    //  これより小さい段はスレッドを待ち合わせる方が遅い
+    constexpr int PARALLEL_THRESHOLD = 1 << 12;
+    //  スレッドごとに持つbucketの数の上限
+    constexpr long long MAX_BUCKETS = 1 << 16;
+    //  段の種類
+    constexpr int SCAN = 0, LIGHT = 1, HEAVY = 2, APPLY = 3, STOP = 4;
+
+    int n = graph.size();
+    T max_weight = 0;
+    for (int u = 0; u < n; u++) {
+        for (const auto& e: graph[u]) {
+            assert(e.weight >= 0);
+            max_weight = std::max(max_weight, e.weight);
+        }
+    }
+    //  bucket番号が[i, i + num_buckets)の頂点はbucketに巡回させて置き, それ以降は overflow に置く
+    //  上限がなければ有効な頂点は全てこの窓に収まる
+    const T ratio = max_weight / delta;
+    const long long num_buckets = ratio < MAX_BUCKETS - 2 ? static_cast<long long>(ratio) + 2 : MAX_BUCKETS;
+    auto bucket_of = [&](T d) -> long long {
+        return static_cast<long long>(d / delta);
+    };
+    //  頂点vの持ち主. 持ち主idの区間は [n * id / threads, n * (id + 1) / threads)
+    auto owner_of = [&](int v) -> int {
+        return ((long long)(v + 1) * threads - 1) / n;
+    };
+
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    //  最後に緩和したときのdist. 同じ値で二回緩和しない
+    std::vector<T> relaxed(n, Result::UNREACHABLE);
+    //  buckets[id][b] := 持ち主idの頂点のうちbucket bに入れたもの
+    std::vector<std::vector<std::vector<int>>> buckets(threads, std::vector<std::vector<int>>(num_buckets));
+    //  overflow[id] := 持ち主idの頂点のうち, 入れたときに窓より先だったもの. (bucket番号, 頂点)
+    using Far = std::pair<long long, int>;
+    std::vector<std::priority_queue<Far, std::vector<Far>, std::greater<Far>>> overflow(threads);
+    //  opened[id] := 持ち主idが空から空でなくしたbucketの番号. 呼び出し元で pending に移す
+    std::vector<std::vector<long long>> opened(threads);
+    std::priority_queue<long long, std::vector<long long>, std::greater<long long>> pending;
+    //  requests[id][owner] := id番のスレッドが作った, 持ち主ownerの頂点への緩和要求
+    std::vector<std::vector<std::vector<Request>>> requests(threads, std::vector<std::vector<Request>>(threads));
+    std::vector<std::vector<int>> frontier_parts(threads), settled_parts(threads);
+    std::vector<int> frontier, settled;
+    //  added[id] := 直前の APPLY で持ち主idがbucketか overflow に入れた頂点数
+    std::vector<long long> added(threads);
+    long long i = 0;
+    //  bucketと overflow に入っている頂点数. 重複や古いものも数える
+    long long remaining = 0;
+    int phase = NONE;
+
+    auto relax = [&](int id, int v, T d, int p) {
+        if (d < dist[v]) {
+            dist[v] = d;
+            parent[v] = p;
+            const long long b = bucket_of(d);
+            if (b < i + num_buckets) {
+                auto& bucket = buckets[id][b % num_buckets];
+                if (bucket.empty()) opened[id].push_back(b);
+                bucket.push_back(v);
+            } else {
+                overflow[id].emplace(b, v);
+            }
+            added[id]++;
+        }
+    };
+
+    //  frontierから出る辺のうち, lightならweight <= delta, heavyならweight > delta の緩和要求を作る
+    //  生成中はdistを書き換えないので, その時点で改善しない要求は捨ててよい
+    auto generate = [&](int id, const std::vector<int>& from, bool light) {
+        auto& out = requests[id];
+        for (auto& to_owner: out) to_owner.clear();
+        const int m = from.size();
+        const int left = (long long)m * id / threads, right = (long long)m * (id + 1) / threads;
+        for (int j = left; j < right; j++) {
+            const int u = from[j];
+            for (const auto& e: graph[u]) {
+                if ((e.weight <= delta) != light) continue;
+                const T d = dist[u] + e.weight;
+                if (d < dist[e.to]) out[owner_of(e.to)].emplace_back(e.to, d, u);
+            }
+        }
+    };
+
+    auto step = [&](int id) {
+        if (phase == SCAN) {
+            //  bucket iのうち古くない頂点を取り出す
+            auto& bucket = buckets[id][i % num_buckets];
+            auto& part = frontier_parts[id];
+            part.clear();
+            for (int v: bucket) {
+                if (bucket_of(dist[v]) != i || relaxed[v] == dist[v]) continue;
+                if (relaxed[v] == Result::UNREACHABLE || bucket_of(relaxed[v]) != i) settled_parts[id].push_back(v);
+                relaxed[v] = dist[v];
+                part.push_back(v);
+            }
+            bucket.clear();
+        } else if (phase == LIGHT || phase == HEAVY) {
+            generate(id, phase == LIGHT ? frontier : settled, phase == LIGHT);
+        } else if (phase == APPLY) {
+            added[id] = 0;
+            for (int from = 0; from < threads; from++) {
+                for (auto [v, d, p]: requests[from][id]) relax(id, v, d, p);
+            }
+        }
+    };
+
+    //  ワーカーは最後まで生かしておき, 各段の前後で barrier で待ち合わせる
+    std::barrier sync(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int id = 1; id < threads; id++) {
+        workers.emplace_back([&, id] {
+            while (true) {
+                sync.arrive_and_wait();
+                if (phase == STOP) return;
+                step(id);
+                sync.arrive_and_wait();
+            }
+        });
+    }
+    //  sizeが小さい段は全てのidを呼び出し元で順に処理する. どちらでも結果は同じ
+    auto run = [&](int next_phase, long long size) {
+        phase = next_phase;
+        if (threads == 1 || size < PARALLEL_THRESHOLD) {
+            for (int id = 0; id < threads; id++) step(id);
+        } else {
+            sync.arrive_and_wait();
+            step(0);
+            sync.arrive_and_wait();
+        }
+    };
+    auto concat = [&](const std::vector<std::vector<int>>& parts, std::vector<int>& out) {
+        out.clear();
+        for (const auto& part: parts) out.insert(out.end(), part.begin(), part.end());
+    };
+    auto bucket_size = [&]() {
+        long long size = 0;
+        for (int id = 0; id < threads; id++) size += buckets[id][i % num_buckets].size();
+        return size;
+    };
+    //  APPLY の後に, 空でなくなったbucketの番号と入れた頂点数を集める
+    auto collect = [&]() {
+        for (int id = 0; id < threads; id++) {
+            remaining += std::exchange(added[id], 0);
+            for (long long b: opened[id]) pending.push(b);
+            opened[id].clear();
+        }
+    };
+    //  overflow のうち窓に入ったものをbucketに移す. 入れた後に距離が縮んで確定済みのものは捨てる
+    auto refill = [&]() {
+        for (int id = 0; id < threads; id++) {
+            auto& far = overflow[id];
+            while (!far.empty() && far.top().first < i + num_buckets) {
+                const int v = far.top().second;
+                far.pop();
+                const long long b = bucket_of(dist[v]);
+                if (b < i) {
+                    remaining--;
+                    continue;
+                }
+                auto& bucket = buckets[id][b % num_buckets];
+                if (bucket.empty()) pending.push(b);
+                bucket.push_back(v);
+            }
+        }
+    };
+
+    for (auto s: source) {
+        assert(0 <= s && s < n);
+        relax(owner_of(s), s, 0, NONE);
+    }
+    collect();
+
+    while (remaining > 0) {
+        //  次に処理するbucketは, 空でないbucketと overflow の先頭のうち最小のもの
+        while (!pending.empty() && pending.top() < i) pending.pop();
+        long long next = pending.empty() ? -1 : pending.top();
+        for (const auto& far: overflow) {
+            if (!far.empty() && (next == -1 || far.top().first < next)) next = far.top().first;
+        }
+        i = next;
+        refill();
+        long long size = bucket_size();
+        if (size == 0) {
+            i++;
+            continue;
+        }
+        for (auto& part: settled_parts) part.clear();
+        //  light edge で同じbucketに入る頂点がなくなるまで繰り返す
+        while (size > 0) {
+            remaining -= size;
+            run(SCAN, size);
+            concat(frontier_parts, frontier);
+            run(LIGHT, frontier.size());
+            run(APPLY, frontier.size());
+            collect();
+            size = bucket_size();
+        }
+        concat(settled_parts, settled);
+        run(HEAVY, settled.size());
+        run(APPLY, settled.size());
+        collect();
+        i++;
+    }
+
+    phase = STOP;
+    if (threads > 1) sync.arrive_and_wait();
+    for (auto& worker: workers) worker.join();
+    return Result(std::move(dist), std::move(parent));
+}
+
+///  # delta stepping(graph, source, delta, threads)
+///  単一始点負辺なしの最短経路問題
+template <class T>
+internal::DijkstraResult<T> delta_stepping(const Graph<T>& graph, int source, T delta, int threads = 1) {
+    return delta_stepping(graph, std::vector<int>{source}, delta, threads);
+}
+
+}  //  namespace nono
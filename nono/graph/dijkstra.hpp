@@ -69,6 +69,56 @@ class DijkstraResult {
     std::vector<int> parent_;
 };
 
+///  # point to point result
+///  二点間の最短経路 (astar, bidirectional dijkstra など) の結果
+///  UNREACHABLE, invalid の意味は DijkstraResult と同じ
+template <class T>
+class PointToPointResult {
+  public:
+    static constexpr T UNREACHABLE = std::numeric_limits<T>::max();
+
+    PointToPointResult(T dist, std::vector<int> path, int settled)
+        : dist_(dist),
+          path_(std::move(path)),
+          settled_(settled) {}
+
+    ///  # dist()
+    ///  distance between source and target
+    ///  if source and target are not connected, return UNREACHABLE
+    ///  O(1)
+    T dist() const {
+        return dist_;
+    }
+
+    ///  # path()
+    ///  return shortest path from source to target
+    ///  source -> ... -> ... -> target
+    ///  if we can not reach target, return empty vector
+    ///  O(|path|)
+    std::vector<int> path() const {
+        return path_;
+    }
+
+    ///  # invalid()
+    ///  whether we can reach target
+    ///  O(1)
+    bool invalid() const {
+        return dist_ == UNREACHABLE;
+    }
+
+    ///  # settled()
+    ///  num of vertices popped from heaps (両方向なら和)
+    ///  O(1)
+    int settled() const {
+        return settled_;
+    }
+
+  private:
+    T dist_;
+    std::vector<int> path_;
+    int settled_;
+};
+
 }  //  namespace internal
 
 ///  # dijkstra
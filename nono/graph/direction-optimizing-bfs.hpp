@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <vector>
+
+#include "../utility/parallel.hpp"
+#include "./base.hpp"
+#include "./bfs.hpp"
+
+namespace nono {
+
+///  # direction optimizing bfs(graph, reverse graph, source, threads)
+///  複数始点bfs. 辺重みは全て1として扱う
+///  top-down: frontierから出る辺を全部見る (普通のbfs)
+///  bottom-up: 未訪問頂点から入ってくる辺を見て, frontierに含まれる頂点を一つ見つけたら打ち切る
+///  frontierから出る辺の本数 > 未訪問頂点に入る辺の本数 / ALPHA なら bottom-up に,
+///  |frontier| < |V| / BETA なら top-down に切り替える
+///  frontierはbitsetで持つ
+///
+///  threads > 1 ならbottom-upを64頂点単位で分割して複数スレッドで行う
+///  parentは決定的 (bottom-upでは入ってくる辺のうち最初に見つかったもの)
+///  直径の小さいグラフで速い
+///  O(V + E)
+template <class T>
+internal::BfsResult<T> direction_optimizing_bfs(const Graph<T>& graph, const Graph<T>& reverse_graph,
+                                                const std::vector<int>& source, int threads = 1) {
+    using Result = internal::BfsResult<T>;
+    assert(graph.size() == reverse_graph.size());
+    assert(threads >= 1);
+    constexpr int NONE = -1;
+    constexpr long long ALPHA = 14;
+    constexpr long long BETA = 24;
+
+    int n = graph.size();
+    int words = (n + 63) / 64;
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    std::vector<unsigned long long> visited(words), in_frontier(words);
+    std::vector<int> frontier, next;
+
+    //  未訪問頂点に入る辺の本数
+    long long unvisited_edges = 0;
+    for (int v = 0; v < n; v++) unvisited_edges += reverse_graph[v].size();
+    auto visit = [&](int v, T d, int p) {
+        dist[v] = d;
+        parent[v] = p;
+        visited[v >> 6] |= 1ULL << (v & 63);
+        unvisited_edges -= reverse_graph[v].size();
+        next.push_back(v);
+    };
+    for (auto s: source) {
+        assert(0 <= s && s < n);
+        if (dist[s] == Result::UNREACHABLE) visit(s, 0, NONE);
+    }
+
+    //  [left, right) 番目のwordに含まれる未訪問頂点を処理する
+    std::vector<std::vector<int>> found(threads);
+    auto bottom_up = [&](int id, int left, int right, T d) {
+        auto& out = found[id];
+        out.clear();
+        for (int w = left; w < right; w++) {
+            unsigned long long rest = ~visited[w];
+            if (w == words - 1 && (n & 63)) rest &= (1ULL << (n & 63)) - 1;
+            while (rest) {
+                int v = (w << 6) | std::countr_zero(rest);
+                rest &= rest - 1;
+                for (const auto& e: reverse_graph[v]) {
+                    if (in_frontier[e.to >> 6] >> (e.to & 63) & 1) {
+                        dist[v] = d;
+                        parent[v] = e.to;
+                        out.push_back(v);
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    bool top_down = true;
+    for (T d = 1; !next.empty(); d++) {
+        std::swap(frontier, next);
+        next.clear();
+        long long frontier_edges = 0;
+        for (int u: frontier) frontier_edges += graph[u].size();
+        if (top_down && frontier_edges * ALPHA > unvisited_edges) {
+            top_down = false;
+        } else if (!top_down && (long long)frontier.size() * BETA < n) {
+            top_down = true;
+        }
+
+        if (top_down) {
+            for (int u: frontier) {
+                for (const auto& e: graph[u]) {
+                    if (dist[e.to] == Result::UNREACHABLE) visit(e.to, d, u);
+                }
+            }
+        } else {
+            for (int u: frontier) in_frontier[u >> 6] |= 1ULL << (u & 63);
+            internal::parallel_for(words, threads,
+                                   [&](int id, int left, int right) { bottom_up(id, left, right, d); });
+            for (const auto& out: found) {
+                for (int v: out) visit(v, d, parent[v]);
+            }
+            for (int u: frontier) in_frontier[u >> 6] = 0;
+        }
+    }
+
+    return Result(std::move(dist), std::move(parent));
+}
+
+///  # direction optimizing bfs(graph, reverse graph, source, threads)
+///  単一始点
+template <class T>
+internal::BfsResult<T> direction_optimizing_bfs(const Graph<T>& graph, const Graph<T>& reverse_graph, int source,
+                                                int threads = 1) {
+    return direction_optimizing_bfs(graph, reverse_graph, std::vector<int>{source}, threads);
+}
+
+///  # direction optimizing bfs(graph, source, threads)
+///  無向グラフ用. 単一始点
+template <class T>
+internal::BfsResult<T> direction_optimizing_bfs(const Graph<T>& graph, int source, int threads = 1) {
+    assert(graph.is_undirected());
+    return direction_optimizing_bfs(graph, graph, std::vector<int>{source}, threads);
+}
+
+}  //  namespace nono
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+#include "../ds/union-find.hpp"
+#include "./base.hpp"
+#include "./kruskal.hpp"
+
+namespace nono {
+
+///  # filter kruskal(n, edges)
+///  最小全域森のコスト、使用する辺を取得する
+///  非連結でも良い (最小全域森を返す)
+///  辺はソートされていなくても良い
+///  quicksortのように重みで分割し, 軽い方を先に処理してから
+///  重い方のうち既に同じ成分を結ぶ辺を捨ててから再帰する
+///  密なグラフでは大半の辺がソートされずに捨てられる
+///  O(m + n log n log (m / n)) くらい (期待)
+template <class T>
+internal::KruskalResult<T> filter_kruskal(int n, const std::vector<EdgeBase<T>>& edges) {
+    using Result = internal::KruskalResult<T>;
+    //  これ以下はソートしてkruskal
+    constexpr int THRESHOLD = 64;
+
+    std::vector<int> edge_id(edges.size());
+    std::iota(edge_id.begin(), edge_id.end(), 0);
+    T cost = 0;
+    std::vector<int> used_edge_id;
+    used_edge_id.reserve(std::max(n - 1, 0));
+    UnionFind uf(n);
+
+    auto weight_less = [&edges](int lhs, int rhs) {
+        return edges[lhs].weight < edges[rhs].weight;
+    };
+    auto scan = [&](auto first, auto last) {
+        for (auto it = first; it != last; ++it) {
+            const auto& e = edges[*it];
+            if (uf.merge(e.from, e.to)) {
+                cost += e.weight;
+                used_edge_id.push_back(*it);
+            }
+        }
+    };
+    //  [first, last) の辺を処理する
+    auto dfs = [&](auto&& self, std::vector<int>::iterator first, std::vector<int>::iterator last) -> void {
+        if (first == last || std::ssize(used_edge_id) == n - 1) return;
+        if (last - first <= THRESHOLD) {
+            std::sort(first, last, weight_less);
+            scan(first, last);
+            return;
+        }
+        //  median of three
+        int a = *first, b = *(first + (last - first) / 2), c = *(last - 1);
+        if (weight_less(b, a)) std::swap(a, b);
+        if (weight_less(c, b)) std::swap(b, c);
+        if (weight_less(b, a)) std::swap(a, b);
+        const T pivot = edges[b].weight;
+        //  [first, mid1) < pivot, [mid1, mid2) == pivot, [mid2, last) > pivot
+        auto mid1 = std::partition(first, last, [&](int i) { return edges[i].weight < pivot; });
+        auto mid2 = std::partition(mid1, last, [&](int i) { return !(pivot < edges[i].weight); });
+        self(self, first, mid1);
+        scan(mid1, mid2);
+        auto heavy = std::partition(mid2, last, [&](int i) { return !uf.same(edges[i].from, edges[i].to); });
+        self(self, mid2, heavy);
+    };
+    dfs(dfs, edge_id.begin(), edge_id.end());
+
+    return Result(cost, used_edge_id);
+}
+
+}  //  namespace nono
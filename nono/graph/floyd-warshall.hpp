@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../math/min-plus-product.hpp"
+#include "../utility/parallel.hpp"
+#include "./base.hpp"
+
+namespace nono {
+
+namespace internal {
+
+template <class T>
+class FloydWarshallResult {
+  public:
+    static constexpr T UNREACHABLE = std::numeric_limits<T>::max();
+
+    FloydWarshallResult(int n, std::vector<T> dist, bool has_negative_cycle)
+        : n_(n),
+          dist_(std::move(dist)),
+          has_negative_cycle_(has_negative_cycle) {}
+
+    ///  # dist(from, to)
+    ///  distance between from and to
+    ///  if from and to are not connected, return UNREACHABLE
+    ///  負閉路があるときは意味を持たない
+    ///  O(1)
+    T dist(int from, int to) const {
+        assert(0 <= from && from < n_);
+        assert(0 <= to && to < n_);
+        return dist_[(long long)from * n_ + to];
+    }
+
+    ///  # invalid(from, to)
+    ///  whether we can not reach to from from
+    ///  O(1)
+    bool invalid(int from, int to) const {
+        return dist(from, to) == UNREACHABLE;
+    }
+
+    ///  # has_negative_cycle()
+    ///  O(1)
+    bool has_negative_cycle() const {
+        return has_negative_cycle_;
+    }
+
+    ///  # raw()
+    ///  return n x n distance array (row-major)
+    std::vector<T> raw() const {
+        return dist_;
+    }
+
+  private:
+    int n_;
+    std::vector<T> dist_;
+    bool has_negative_cycle_;
+};
+
+}  //  namespace internal
+
+///  # floyd_warshall(n, edges, threads)
+///  全点対最短路. 負辺があってもよい (有向)
+///  距離行列を一次元で持ち, 一辺 MIN_PLUS_BLOCK のブロックごとに三段階で更新する (blocked Floyd-Warshall)
+///  1. 対角ブロックを普通のFloyd-Warshallで閉じる
+///  2. 同じ行, 列のブロックに対角ブロックを掛ける
+///  3. 残りのブロックに, 2.で求めた列ブロックと行ブロックのmin-plus積を足し込む
+///  手間のほとんどは3.で, ブロックはキャッシュに載り, 最内ループはベクトル化される
+///  threads > 1 なら2.と3.をブロックの行ごとに分担する
+///  負閉路が見つかった時点で打ち切るので, 値があふれることはない
+///  重みの絶対値の和は max / 4 未満であること
+///  O(n^3 / threads) time, O(n^2) memory
+template <class T>
+internal::FloydWarshallResult<T> floyd_warshall(int n, const std::vector<EdgeBase<T>>& edges, int threads = 1) {
+    using Result = internal::FloydWarshallResult<T>;
+    using internal::MIN_PLUS_BLOCK;
+    constexpr T INF = internal::MIN_PLUS_INF<T>;
+    assert(0 <= n);
+    assert(threads >= 1);
+
+    //  ブロックの倍数に揃える. 増やした頂点は孤立点
+    const int size = internal::pad_to_block(n);
+    const int blocks = size / MIN_PLUS_BLOCK;
+    std::vector<T> dist((long long)size * size, INF);
+    auto at = [&](int i, int j) -> T& {
+        return dist[(long long)i * size + j];
+    };
+    for (int v = 0; v < size; v++) at(v, v) = 0;
+    for (const auto& e: edges) {
+        assert(0 <= e.from && e.from < n);
+        assert(0 <= e.to && e.to < n);
+        at(e.from, e.to) = std::min(at(e.from, e.to), e.weight);
+    }
+    auto block = [&](int ib, int jb) {
+        return dist.data() + (long long)ib * MIN_PLUS_BLOCK * size + (long long)jb * MIN_PLUS_BLOCK;
+    };
+    //  [0, count) をthreads個に分けてwork(i)を呼ぶ
+    auto parallel = [&](int count, auto work) {
+        internal::parallel_for(count, threads, [&](int, int left, int right) {
+            for (int i = left; i < right; i++) work(i);
+        });
+    };
+
+    bool has_negative_cycle = false;
+    for (int v = 0; v < n && !has_negative_cycle; v++) has_negative_cycle = at(v, v) < 0;
+    for (int kb = 0; kb < blocks && !has_negative_cycle; kb++) {
+        //  1. 対角ブロック. kを経由点に加えたときに自分への距離が負になれば負閉路
+        const int offset = kb * MIN_PLUS_BLOCK;
+        for (int k = offset; k < offset + MIN_PLUS_BLOCK; k++) {
+            for (int i = offset; i < offset + MIN_PLUS_BLOCK; i++) {
+                const T x = at(i, k);
+                for (int j = offset; j < offset + MIN_PLUS_BLOCK; j++) at(i, j) = std::min(at(i, j), x + at(k, j));
+            }
+            if (at(k, k) < 0) {
+                has_negative_cycle = true;
+                break;
+            }
+        }
+        if (has_negative_cycle) break;
+
+        //  2. 対角ブロックは閉じていて対角が0なので, 一度掛ければよい
+        //     行ブロックはcとbが重なり更新後の値も読むが, 実在する路の長さに下がるだけなので結果は同じ
+        const T* diagonal = block(kb, kb);
+        parallel(blocks, [&](int b) {
+            if (b == kb) return;
+            internal::min_plus_block(block(kb, b), size, diagonal, size, block(kb, b), size);
+            internal::min_plus_block(block(b, kb), size, block(b, kb), size, diagonal, size);
+        });
+
+        //  3. 行ブロックごとに分担する. 書き込むブロックは互いに重ならない
+        parallel(blocks, [&](int ib) {
+            if (ib == kb) return;
+            for (int jb = 0; jb < blocks; jb++) {
+                if (jb == kb) continue;
+                internal::min_plus_block(block(ib, jb), size, block(ib, kb), size, block(kb, jb), size);
+            }
+        });
+    }
+
+    std::vector<T> result((long long)n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            T d = at(i, j);
+            result[(long long)i * n + j] = d >= INF / 2 ? Result::UNREACHABLE : d;
+        }
+    }
+    return Result(n, std::move(result), has_negative_cycle);
+}
+
+}  //  namespace nono
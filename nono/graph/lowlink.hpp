@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "../ds/csr-array.hpp"
+#include "./base.hpp"
+
+namespace nono {
+
+namespace internal {
+
+///  # lowlink result
+///  橋, 関節点, 二辺連結成分, 二重頂点連結成分をまとめて持つ
+class LowLinkResult {
+  public:
+    LowLinkResult(std::vector<int> bridges, std::vector<int> articulation_points,
+                  std::vector<int> two_edge_connected_component_ids, CSRArray<int> two_edge_connected_components,
+                  CSRArray<int> biconnected_components)
+        : bridges_(std::move(bridges)),
+          articulation_points_(std::move(articulation_points)),
+          two_edge_connected_component_ids_(std::move(two_edge_connected_component_ids)),
+          two_edge_connected_components_(std::move(two_edge_connected_components)),
+          biconnected_components_(std::move(biconnected_components)) {}
+
+    ///  # bridges()
+    ///  edge ids of bridges
+    ///  bridge: その辺を取り除くとグラフが非連結となるような辺.
+    const std::vector<int>& bridges() const {
+        return bridges_;
+    }
+
+    ///  # articulation points()
+    ///  関節点 (頂点番号の昇順)
+    const std::vector<int>& articulation_points() const {
+        return articulation_points_;
+    }
+
+    ///  # two edge connected component ids()
+    ///  ids[v] := 頂点vを含む二辺連結成分の番号
+    const std::vector<int>& two_edge_connected_component_ids() const {
+        return two_edge_connected_component_ids_;
+    }
+
+    ///  # two edge connected components()
+    ///  [i] := 二辺連結成分iに含まれる頂点
+    const CSRArray<int>& two_edge_connected_components() const {
+        return two_edge_connected_components_;
+    }
+
+    ///  # biconnected components()
+    ///  [i] := 二重頂点連結成分iに含まれる頂点
+    ///  関節点は複数の成分に含まれる. 孤立点は単独で一つの成分
+    const CSRArray<int>& biconnected_components() const {
+        return biconnected_components_;
+    }
+
+  private:
+    std::vector<int> bridges_;
+    std::vector<int> articulation_points_;
+    std::vector<int> two_edge_connected_component_ids_;
+    CSRArray<int> two_edge_connected_components_;
+    CSRArray<int> biconnected_components_;
+};
+
+}  //  namespace internal
+
+///  # lowlink(graph)
+///  一回のdfsで橋, 関節点, 二辺連結成分, 二重頂点連結成分を求める
+///  無向グラフでないと壊れる
+///  連結非連結, 単純非単純を問わない
+///  再帰しないので深いグラフでも大丈夫
+///  O(V + E)
+template <class T>
+internal::LowLinkResult lowlink(const Graph<T>& graph) {
+    assert(graph.is_undirected());
+    constexpr int NONE = -1;
+
+    int n = graph.size();
+    std::vector<int> order(n, NONE);
+    std::vector<int> low(n);
+    std::vector<int> parent(n, NONE);
+    std::vector<int> parent_edge(n, NONE);
+    //  次に見る辺の位置
+    std::vector<int> position(n);
+    std::vector<bool> is_articulation(n);
+    std::vector<bool> is_bridge(graph.edge_size());
+    std::vector<int> preorder;
+    std::vector<int> call_stack;
+    std::vector<int> vertex_stack;
+    preorder.reserve(n);
+
+    std::vector<int> bridges;
+    //  二重頂点連結成分 (成分番号, 頂点)
+    std::vector<int> bcc_row, bcc_vertex;
+    int bcc_count = 0;
+
+    int now = 0;
+    for (int root = 0; root < n; root++) {
+        if (order[root] != NONE) continue;
+        order[root] = low[root] = now++;
+        preorder.push_back(root);
+        call_stack.push_back(root);
+        vertex_stack.push_back(root);
+        int root_children = 0;
+        while (!call_stack.empty()) {
+            int u = call_stack.back();
+            auto adj = graph[u];
+            if (position[u] < std::ssize(adj)) {
+                const auto& e = adj[position[u]++];
+                if (e.id == parent_edge[u]) continue;
+                if (order[e.to] == NONE) {
+                    parent[e.to] = u;
+                    parent_edge[e.to] = e.id;
+                    order[e.to] = low[e.to] = now++;
+                    preorder.push_back(e.to);
+                    call_stack.push_back(e.to);
+                    vertex_stack.push_back(e.to);
+                    if (u == root) root_children++;
+                } else {
+                    low[u] = std::min(low[u], order[e.to]);
+                }
+                continue;
+            }
+            call_stack.pop_back();
+            int p = parent[u];
+            if (p == NONE) continue;
+            low[p] = std::min(low[p], low[u]);
+            if (order[p] < low[u]) {
+                is_bridge[parent_edge[u]] = true;
+                bridges.push_back(parent_edge[u]);
+            }
+            if (order[p] <= low[u]) {
+                if (p != root) is_articulation[p] = true;
+                while (true) {
+                    int v = vertex_stack.back();
+                    vertex_stack.pop_back();
+                    bcc_row.push_back(bcc_count);
+                    bcc_vertex.push_back(v);
+                    if (v == u) break;
+                }
+                bcc_row.push_back(bcc_count);
+                bcc_vertex.push_back(p);
+                bcc_count++;
+            }
+        }
+        assert(vertex_stack.size() == 1 && vertex_stack.back() == root);
+        vertex_stack.pop_back();
+        if (root_children == 0) {
+            bcc_row.push_back(bcc_count);
+            bcc_vertex.push_back(root);
+            bcc_count++;
+        }
+        if (root_children >= 2) is_articulation[root] = true;
+    }
+
+    std::vector<int> articulation_points;
+    for (int v = 0; v < n; v++) {
+        if (is_articulation[v]) articulation_points.push_back(v);
+    }
+
+    //  行きがけ順に見て, 親への辺が橋なら新しい成分
+    std::vector<int> two_edge_ids(n);
+    int two_edge_count = 0;
+    for (int v: preorder) {
+        if (parent[v] == NONE || is_bridge[parent_edge[v]]) {
+            two_edge_ids[v] = two_edge_count++;
+        } else {
+            two_edge_ids[v] = two_edge_ids[parent[v]];
+        }
+    }
+    std::vector<int> vertices(n);
+    for (int v = 0; v < n; v++) vertices[v] = v;
+
+    return internal::LowLinkResult(std::move(bridges), std::move(articulation_points), two_edge_ids,
+                                   CSRArray<int>(two_edge_count, two_edge_ids, vertices),
+                                   CSRArray<int>(bcc_count, bcc_row, bcc_vertex));
+}
+
+}  //  namespace nono
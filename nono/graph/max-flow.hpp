@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace nono {
+
+///  # MaxFlow
+///  最大流. Dinic と highest-label push-relabel の二通りで流せる
+///  残余グラフはCSRで一つの配列に詰めて持ち, 辺を追加したら次に流すときに作り直す
+///  流量は保持されるので, 容量を増やしてから流すと増えた分だけ追加で流れる
+template <class T>
+class MaxFlow {
+  public:
+    static constexpr T INF = std::numeric_limits<T>::max();
+
+    struct Edge {
+        int from;
+        int to;
+        T cap;
+        T flow;
+    };
+
+    MaxFlow(): MaxFlow(0) {}
+    explicit MaxFlow(int n): n_(n) {}
+
+    ///  # size()
+    ///  num of vertices
+    int size() const {
+        return n_;
+    }
+
+    ///  # add_edge(from, to, cap)
+    ///  from -> to に容量capの辺を追加して辺番号を返す
+    ///  O(1) (次に流すときにO(V + E)かけて残余グラフを作り直す)
+    int add_edge(int from, int to, T cap) {
+        assert(0 <= from && from < n_);
+        assert(0 <= to && to < n_);
+        assert(0 <= cap);
+        sync();
+        built_ = false;
+        from_.push_back(from);
+        to_.push_back(to);
+        cap_.push_back(cap);
+        flow_.push_back(0);
+        return from_.size() - 1;
+    }
+
+    ///  # get_edge(i)
+    ///  O(1)
+    Edge get_edge(int i) const {
+        assert(0 <= i && i < std::ssize(from_));
+        return Edge{from_[i], to_[i], cap_[i], current_flow(i)};
+    }
+
+    ///  # edges()
+    ///  O(E)
+    std::vector<Edge> edges() const {
+        std::vector<Edge> result(from_.size());
+        for (int i = 0; i < std::ssize(from_); i++) result[i] = get_edge(i);
+        return result;
+    }
+
+    ///  # change_edge(i, cap, flow)
+    ///  辺iの容量と流量を書き換える
+    ///  流量保存則は呼び出し側で守ること
+    ///  O(1)
+    void change_edge(int i, T cap, T flow) {
+        assert(0 <= i && i < std::ssize(from_));
+        assert(0 <= flow && flow <= cap);
+        cap_[i] = cap;
+        if (built_) {
+            int a = arc_[i];
+            residual_[a] = cap - flow;
+            residual_[rev_[a]] = flow;
+        } else {
+            flow_[i] = flow;
+        }
+    }
+
+    ///  # change_capacity(i, cap)
+    ///  流量はそのままで辺iの容量を変える. 今の流量以上でないといけない
+    ///  この後 flow(s, t) を呼ぶと差分だけ流す
+    ///  O(1)
+    void change_capacity(int i, T cap) {
+        change_edge(i, cap, get_edge(i).flow);
+    }
+
+    ///  # flow(s, t, limit)
+    ///  Dinic. s -> t にlimitまで追加で流して, 流した量を返す
+    ///  current arc と非再帰のdfsでブロッキングフローを求める
+    ///  O(V^2 E), 容量が全て1なら O(E min(V^{2/3}, E^{1/2}))
+    T flow(int s, int t, T limit = INF) {
+        assert(0 <= s && s < n_);
+        assert(0 <= t && t < n_);
+        assert(s != t);
+        build();
+        constexpr int NONE = -1;
+
+        std::vector<int> level(n_);
+        std::vector<int> iter(n_);
+        std::vector<int> queue(n_);
+        std::vector<int> path;
+        T total = 0;
+        while (total < limit) {
+            //  sからの距離
+            std::fill(level.begin(), level.end(), NONE);
+            level[s] = 0;
+            int head = 0, tail = 0;
+            queue[tail++] = s;
+            while (head < tail && level[t] == NONE) {
+                int u = queue[head++];
+                for (int a = start_[u]; a < start_[u + 1]; a++) {
+                    int v = head_[a];
+                    if (residual_[a] > 0 && level[v] == NONE) {
+                        level[v] = level[u] + 1;
+                        queue[tail++] = v;
+                    }
+                }
+            }
+            if (level[t] == NONE) break;
+
+            //  ブロッキングフロー. pathはsから今いる頂点までの辺
+            std::copy(start_.begin(), start_.end() - 1, iter.begin());
+            path.clear();
+            int u = s;
+            while (true) {
+                if (u == t) {
+                    T f = limit - total;
+                    for (int a: path) f = std::min(f, residual_[a]);
+                    for (int a: path) {
+                        residual_[a] -= f;
+                        residual_[rev_[a]] += f;
+                    }
+                    total += f;
+                    if (total == limit) break;
+                    //  最初に飽和した辺の手前まで戻る
+                    int k = 0;
+                    while (residual_[path[k]] > 0) k++;
+                    path.resize(k);
+                    u = path.empty() ? s : head_[path.back()];
+                    continue;
+                }
+                //  tと同じ深さ以上の頂点からはtに届かない
+                int& a = iter[u];
+                while (a < start_[u + 1]) {
+                    int v = head_[a];
+                    if (residual_[a] > 0 && level[v] == level[u] + 1 && (v == t || level[v] < level[t])) break;
+                    a++;
+                }
+                if (a < start_[u + 1]) {
+                    path.push_back(a);
+                    u = head_[a];
+                    continue;
+                }
+                //  行き止まりなので二度と入らないようにして戻る
+                level[u] = NONE;
+                if (path.empty()) break;
+                path.pop_back();
+                u = path.empty() ? s : head_[path.back()];
+            }
+        }
+        return total;
+    }
+
+    ///  # push_relabel(s, t)
+    ///  highest-label push-relabel. s -> t に流せるだけ追加で流して, 流した量を返す
+    ///  gap heuristic と定期的な global relabeling を行う
+    ///  余剰はsに押し戻すので, 終わった時点で正しいフローになっている
+    ///  sから出る辺の容量の和がTに収まること
+    ///  O(V^2 E^{1/2})
+    T push_relabel(int s, int t) {
+        assert(0 <= s && s < n_);
+        assert(0 <= t && t < n_);
+        assert(s != t);
+        build();
+        const int n = n_;
+        //  高さ 2n は「どこにも届かない」
+        const int DEAD = 2 * n;
+
+        std::vector<int> height(n, DEAD);
+        std::vector<T> excess(n);
+        std::vector<int> iter(n);
+        std::vector<int> count(DEAD + 1);
+        std::vector<std::vector<int>> active(DEAD);
+        std::vector<int> queue(n);
+        int highest = 0;
+
+        auto activate = [&](int v) {
+            if (v == s || v == t || height[v] >= DEAD) return;
+            active[height[v]].push_back(v);
+            highest = std::max(highest, height[v]);
+        };
+        //  残余グラフでtへの距離, 届かなければ n + sへの距離
+        auto global_relabel = [&]() {
+            std::fill(height.begin(), height.end(), DEAD);
+            std::fill(count.begin(), count.end(), 0);
+            for (auto& bucket: active) bucket.clear();
+            highest = 0;
+            height[t] = 0;
+            height[s] = n;
+            for (int root: {t, s}) {
+                int head = 0, tail = 0;
+                queue[tail++] = root;
+                while (head < tail) {
+                    int u = queue[head++];
+                    for (int a = start_[u]; a < start_[u + 1]; a++) {
+                        int v = head_[a];
+                        if (height[v] == DEAD && residual_[rev_[a]] > 0) {
+                            height[v] = height[u] + 1;
+                            queue[tail++] = v;
+                        }
+                    }
+                }
+            }
+            for (int v = 0; v < n; v++) {
+                count[height[v]]++;
+                iter[v] = start_[v];
+                if (excess[v] > 0) activate(v);
+            }
+        };
+
+        for (int a = start_[s]; a < start_[s + 1]; a++) {
+            T f = residual_[a];
+            residual_[a] -= f;
+            residual_[rev_[a]] += f;
+            excess[s] -= f;
+            excess[head_[a]] += f;
+        }
+        global_relabel();
+
+        int relabel_count = 0;
+        while (highest >= 0) {
+            if (active[highest].empty()) {
+                highest--;
+                continue;
+            }
+            int u = active[highest].back();
+            active[highest].pop_back();
+            //  高さが変わって古くなったもの
+            if (height[u] != highest || excess[u] == 0) continue;
+
+            //  discharge
+            while (excess[u] > 0) {
+                if (iter[u] == start_[u + 1]) {
+                    int old = height[u];
+                    int next = DEAD;
+                    for (int a = start_[u]; a < start_[u + 1]; a++) {
+                        if (residual_[a] > 0) next = std::min(next, height[head_[a]] + 1);
+                    }
+                    count[old]--;
+                    height[u] = next;
+                    count[next]++;
+                    iter[u] = start_[u];
+                    relabel_count++;
+                    if (old < n && count[old] == 0) {
+                        //  gap: oldより上の頂点はtに届かない
+                        for (int v = 0; v < n; v++) {
+                            if (old < height[v] && height[v] < n) {
+                                count[height[v]]--;
+                                height[v] = n + 1;
+                                count[n + 1]++;
+                                iter[v] = start_[v];
+                                if (v != u && excess[v] > 0) activate(v);
+                            }
+                        }
+                    }
+                    if (height[u] >= DEAD) break;
+                    continue;
+                }
+                int a = iter[u];
+                int v = head_[a];
+                if (residual_[a] > 0 && height[u] == height[v] + 1) {
+                    T f = std::min(excess[u], residual_[a]);
+                    residual_[a] -= f;
+                    residual_[rev_[a]] += f;
+                    excess[u] -= f;
+                    if (excess[v] == 0) activate(v);
+                    excess[v] += f;
+                    if (excess[u] == 0) break;
+                }
+                iter[u]++;
+            }
+            if (excess[u] > 0) activate(u);
+            if (relabel_count >= n) {
+                relabel_count = 0;
+                global_relabel();
+            }
+        }
+        assert(excess[s] + excess[t] == 0);
+        return excess[t];
+    }
+
+    ///  # min_cut(s)
+    ///  残余グラフでsから到達できるか
+    ///  最大流を流した後に呼ぶと, trueの側がsを含む最小カット
+    ///  O(V + E)
+    std::vector<bool> min_cut(int s) {
+        assert(0 <= s && s < n_);
+        build();
+        std::vector<bool> visited(n_);
+        std::vector<int> stack = {s};
+        visited[s] = true;
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (int a = start_[u]; a < start_[u + 1]; a++) {
+                int v = head_[a];
+                if (residual_[a] > 0 && !visited[v]) {
+                    visited[v] = true;
+                    stack.push_back(v);
+                }
+            }
+        }
+        return visited;
+    }
+
+  private:
+    int n_;
+    bool built_ = false;
+    //  辺ごとの情報. flow_は残余グラフを作っていない間だけ正しい
+    std::vector<int> from_, to_;
+    std::vector<T> cap_, flow_;
+    //  残余グラフ. 頂点uから出る弧は [start_[u], start_[u + 1])
+    std::vector<int> start_;
+    std::vector<int> head_;
+    std::vector<int> rev_;
+    std::vector<T> residual_;
+    //  arc_[i] := 辺iの順方向の弧
+    std::vector<int> arc_;
+
+    T current_flow(int i) const {
+        return built_ ? residual_[rev_[arc_[i]]] : flow_[i];
+    }
+
+    void sync() {
+        if (!built_) return;
+        for (int i = 0; i < std::ssize(from_); i++) flow_[i] = current_flow(i);
+    }
+
+    void build() {
+        if (built_) return;
+        int m = from_.size();
+        start_.assign(n_ + 1, 0);
+        for (int i = 0; i < m; i++) {
+            start_[from_[i] + 1]++;
+            start_[to_[i] + 1]++;
+        }
+        for (int u = 0; u < n_; u++) start_[u + 1] += start_[u];
+        head_.resize(2 * m);
+        rev_.resize(2 * m);
+        residual_.resize(2 * m);
+        arc_.resize(m);
+        auto index = start_;
+        for (int i = 0; i < m; i++) {
+            int a = index[from_[i]]++;
+            int b = index[to_[i]]++;
+            head_[a] = to_[i];
+            head_[b] = from_[i];
+            rev_[a] = b;
+            rev_[b] = a;
+            residual_[a] = cap_[i] - flow_[i];
+            residual_[b] = flow_[i];
+            arc_[i] = a;
+        }
+        built_ = true;
+    }
+};
+
+}  //  namespace nono
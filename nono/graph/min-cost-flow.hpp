@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace nono {
+
+///  # MinCostFlow
+///  最小費用流. 辺のコストは非負
+///  ポテンシャルを持って被約コストを非負に保ち, dijkstraで最短路長を求めてから
+///  最短路だけからなるグラフにdfsでまとめて流す (primal-dual)
+///  残余グラフはCSRで一つの配列に詰めて持つ
+///  flowを呼んだ後も続きから流せるが, 辺は追加できない
+template <class T>
+class MinCostFlow {
+  public:
+    static constexpr T INF = std::numeric_limits<T>::max();
+
+    struct Edge {
+        int from;
+        int to;
+        T cap;
+        T flow;
+        T cost;
+    };
+
+    MinCostFlow(): MinCostFlow(0) {}
+    explicit MinCostFlow(int n): n_(n) {}
+
+    ///  # size()
+    ///  num of vertices
+    int size() const {
+        return n_;
+    }
+
+    ///  # add_edge(from, to, cap, cost)
+    ///  from -> to に容量cap, 単位コストcostの辺を追加して辺番号を返す
+    ///  O(1)
+    int add_edge(int from, int to, T cap, T cost) {
+        assert(!built_);
+        assert(0 <= from && from < n_);
+        assert(0 <= to && to < n_);
+        assert(0 <= cap);
+        assert(0 <= cost);
+        from_.push_back(from);
+        to_.push_back(to);
+        cap_.push_back(cap);
+        cost_.push_back(cost);
+        return from_.size() - 1;
+    }
+
+    ///  # get_edge(i)
+    ///  O(1)
+    Edge get_edge(int i) const {
+        assert(0 <= i && i < std::ssize(from_));
+        T flow = built_ ? residual_[rev_[arc_[i]]] : 0;
+        return Edge{from_[i], to_[i], cap_[i], flow, cost_[i]};
+    }
+
+    ///  # edges()
+    ///  O(E)
+    std::vector<Edge> edges() const {
+        std::vector<Edge> result(from_.size());
+        for (int i = 0; i < std::ssize(from_); i++) result[i] = get_edge(i);
+        return result;
+    }
+
+    ///  # flow(s, t, limit)
+    ///  s -> t にlimitまで流して (流量, コスト) を返す
+    ///  O(F (V + E) log (V + E)) (F := 最短路長の種類数 <= 増加路の本数)
+    std::pair<T, T> flow(int s, int t, T limit = INF) {
+        return slope(s, t, limit).back();
+    }
+
+    ///  # slope(s, t, limit)
+    ///  流量とコストの関係 (下に凸な折れ線) の折れ点を返す
+    ///  最初は (0, 0), 最後は flow(s, t, limit) と同じ
+    ///  O(F (V + E) log (V + E)) (F := 最短路長の種類数 <= 増加路の本数)
+    std::vector<std::pair<T, T>> slope(int s, int t, T limit = INF) {
+        assert(0 <= s && s < n_);
+        assert(0 <= t && t < n_);
+        assert(s != t);
+        build();
+
+        std::vector<T> dist(n_);
+        std::vector<bool> visited(n_);
+        std::vector<int> settled;
+        std::vector<int> iter(n_);
+        std::vector<int> path;
+        //  dfsでの頂点の状態
+        enum : char { FREE, ON_PATH, DEAD };
+        std::vector<char> state(n_);
+        //  (距離, 頂点) のヒープ. 使い回す
+        std::vector<std::pair<T, int>> heap;
+
+        T flow = 0, cost = 0;
+        //  直前の増加路の単位コスト. 単位コストは非負なので最初は-1
+        T prev_cost = -1;
+        std::vector<std::pair<T, T>> result = {{0, 0}};
+        while (flow < limit) {
+            std::fill(dist.begin(), dist.end(), INF);
+            std::fill(visited.begin(), visited.end(), false);
+            settled.clear();
+            heap.clear();
+            dist[s] = 0;
+            heap.emplace_back(0, s);
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                int u = heap.back().second;
+                heap.pop_back();
+                if (visited[u]) continue;
+                visited[u] = true;
+                settled.push_back(u);
+                if (u == t) break;
+                for (int a = start_[u]; a < start_[u + 1]; a++) {
+                    if (residual_[a] == 0) continue;
+                    int v = head_[a];
+                    //  被約コストは非負
+                    T reduced = arc_cost_[a] + potential_[u] - potential_[v];
+                    assert(0 <= reduced);
+                    T next = dist[u] + reduced;
+                    //  tより遠い頂点は確定しないので積まない
+                    if (visited[v] || next >= dist[v] || next > dist[t]) continue;
+                    dist[v] = next;
+                    heap.emplace_back(next, v);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                }
+            }
+            if (!visited[t]) break;
+            //  確定した頂点だけ動かしても被約コストは非負のまま
+            for (int v: settled) potential_[v] -= dist[t] - dist[v];
+            //  被約コスト0の辺だけを通るs-t路は全て最短路で, 単位コストは等しい
+            const T unit = potential_[t] - potential_[s];
+
+            //  確定した頂点の間の被約コスト0の辺だけを, tから逆向きにdfsして流せるだけ流す
+            //  確定した頂点はsから被約コスト0で辿れるので, 逆向きだとほぼ行き止まらない
+            //  current arc を使い, 行き止まりと今の路上の頂点には入らない
+            //  path[i] := x[i + 1] -> x[i] の弧 (x[0] = t)
+            const T before = flow;
+            for (int v: settled) {
+                iter[v] = start_[v];
+                state[v] = FREE;
+            }
+            path.clear();
+            int u = t;
+            state[t] = ON_PATH;
+            while (flow < limit) {
+                if (u == s) {
+                    T f = limit - flow;
+                    for (int a: path) f = std::min(f, residual_[a]);
+                    for (int a: path) {
+                        residual_[a] -= f;
+                        residual_[rev_[a]] += f;
+                    }
+                    flow += f;
+                    //  tに一番近い飽和した辺の手前まで戻る
+                    int k = 0;
+                    while (k < std::ssize(path) && residual_[path[k]] > 0) k++;
+                    for (int i = k; i < std::ssize(path); i++) state[head_[rev_[path[i]]]] = FREE;
+                    path.resize(k);
+                    u = path.empty() ? t : head_[rev_[path.back()]];
+                    continue;
+                }
+                int& b = iter[u];
+                while (b < start_[u + 1]) {
+                    int w = head_[b];
+                    if (visited[w] && state[w] == FREE && admissible(w, rev_[b])) break;
+                    b++;
+                }
+                if (b < start_[u + 1]) {
+                    path.push_back(rev_[b]);
+                    u = head_[b];
+                    state[u] = ON_PATH;
+                    continue;
+                }
+                state[u] = DEAD;
+                if (path.empty()) break;
+                path.pop_back();
+                u = path.empty() ? t : head_[rev_[path.back()]];
+            }
+            cost += (flow - before) * unit;
+            if (prev_cost == unit) result.pop_back();
+            result.emplace_back(flow, cost);
+            prev_cost = unit;
+        }
+        return result;
+    }
+
+  private:
+    int n_;
+    bool built_ = false;
+    std::vector<int> from_, to_;
+    std::vector<T> cap_, cost_;
+    //  残余グラフ. 頂点uから出る弧は [start_[u], start_[u + 1])
+    std::vector<int> start_;
+    std::vector<int> head_;
+    std::vector<int> rev_;
+    std::vector<T> residual_;
+    std::vector<T> arc_cost_;
+    //  arc_[i] := 辺iの順方向の弧
+    std::vector<int> arc_;
+    std::vector<T> potential_;
+
+    bool admissible(int u, int a) const {
+        return residual_[a] > 0 && arc_cost_[a] + potential_[u] - potential_[head_[a]] == 0;
+    }
+
+    void build() {
+        if (built_) return;
+        int m = from_.size();
+        start_.assign(n_ + 1, 0);
+        for (int i = 0; i < m; i++) {
+            start_[from_[i] + 1]++;
+            start_[to_[i] + 1]++;
+        }
+        for (int u = 0; u < n_; u++) start_[u + 1] += start_[u];
+        head_.resize(2 * m);
+        rev_.resize(2 * m);
+        residual_.resize(2 * m);
+        arc_cost_.resize(2 * m);
+        arc_.resize(m);
+        auto index = start_;
+        for (int i = 0; i < m; i++) {
+            int a = index[from_[i]]++;
+            int b = index[to_[i]]++;
+            head_[a] = to_[i];
+            head_[b] = from_[i];
+            rev_[a] = b;
+            rev_[b] = a;
+            residual_[a] = cap_[i];
+            residual_[b] = 0;
+            arc_cost_[a] = cost_[i];
+            arc_cost_[b] = -cost_[i];
+            arc_[i] = a;
+        }
+        potential_.assign(n_, 0);
+        built_ = true;
+    }
+};
+
+}  //  namespace nono
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "./dijkstra.hpp"
+#include "./segment-edge.hpp"
+
+namespace nono {
+
+///  # segment edge dijkstra(n, segment edges, source)
+///  区間辺集合のまま, 補助頂点を作らずに複数始点負辺なしの最短経路を求める
+///  区間辺 [a, b) -> [c, d) は, [a, b) で最初に確定した頂点から一度だけ使えばよく,
+///  そのとき [c, d) のまだ確定していない頂点は全てそこで確定する
+///  - 区間辺を左端でソートし, 右端の最大値をsegment treeに載せて「uを含む未使用の区間辺」を探す
+///  - 未確定の頂点をsegment treeに載せて「[c, d) の未確定の頂点」を探す
+///  各頂点は一度だけ確定し, 各区間辺は一度だけヒープに入る
+///  経路は元のグラフの頂点で返す
+///  O((n + m) log (n + m)) time, O(n + m) memory
+template <class T>
+internal::DijkstraResult<T> segment_edge_dijkstra(int n, const std::vector<SegmentEdge<T>>& seg_edges,
+                                                  const std::vector<int>& source) {
+    using Result = internal::DijkstraResult<T>;
+    constexpr int NONE = -1;
+    int m = seg_edges.size();
+
+    //  左端でソートした区間辺. upper[u] := 左端がu以下の区間辺の数
+    std::vector<int> upper(n + 2);
+    for (const auto& e: seg_edges) {
+        auto [a, b] = e.from;
+        auto [c, d] = e.to;
+        assert(0 <= a && a <= b && b <= n);
+        assert(0 <= c && c <= d && d <= n);
+        assert(0 <= e.weight);
+        upper[a + 1]++;
+    }
+    for (int u = 0; u <= n; u++) upper[u + 1] += upper[u];
+    std::vector<int> order(m);
+    {
+        auto index = upper;
+        for (int i = 0; i < m; i++) order[index[seg_edges[i].from.first]++] = i;
+    }
+    upper.erase(upper.begin());
+
+    //  right[i] := 未使用なら order[i] の右端, 使用済みなら -1 (の区間max)
+    const int edge_size = std::bit_ceil((unsigned)std::max(m, 1));
+    std::vector<int> right(2 * edge_size, NONE);
+    for (int i = 0; i < m; i++) {
+        const auto& e = seg_edges[order[i]];
+        if (e.to.first < e.to.second) right[edge_size + i] = e.from.second;
+    }
+    for (int i = edge_size - 1; i >= 1; i--) right[i] = std::max(right[2 * i], right[2 * i + 1]);
+    //  [0, limit) で right > u を満たす最初の位置
+    auto find_edge = [&](auto&& self, int node, int left, int width, int limit, int u) -> int {
+        if (limit <= left || right[node] <= u) return NONE;
+        if (width == 1) return left;
+        int result = self(self, 2 * node, left, width / 2, limit, u);
+        if (result != NONE) return result;
+        return self(self, 2 * node + 1, left + width / 2, width / 2, limit, u);
+    };
+
+    //  alive[i] := 未確定の頂点があるか
+    const int vertex_size = std::bit_ceil((unsigned)std::max(n, 1));
+    std::vector<char> alive(2 * vertex_size);
+    for (int v = 0; v < n; v++) alive[vertex_size + v] = 1;
+    for (int i = vertex_size - 1; i >= 1; i--) alive[i] = alive[2 * i] | alive[2 * i + 1];
+    //  l以上で最初の未確定の頂点. なければn
+    auto find_vertex = [&](int l) -> int {
+        if (n <= l) return n;
+        int x = l + vertex_size;
+        if (!alive[x]) {
+            while (true) {
+                if (x == 1) return n;
+                if (!(x & 1) && alive[x + 1]) {
+                    x++;
+                    break;
+                }
+                x >>= 1;
+            }
+            while (x < vertex_size) x = alive[2 * x] ? 2 * x : 2 * x + 1;
+        }
+        return x - vertex_size;
+    };
+
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    //  fired_by[i] := 区間辺iを使った頂点
+    std::vector<int> fired_by(m, NONE);
+    //  (距離, 区間辺)
+    std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>, std::greater<std::pair<T, int>>> que;
+
+    auto settle = [&](int v, T d, int p) {
+        dist[v] = d;
+        parent[v] = p;
+        int x = v + vertex_size;
+        alive[x] = 0;
+        for (x >>= 1; x >= 1 && alive[x]; x >>= 1) alive[x] = alive[2 * x] | alive[2 * x + 1];
+        //  vを含む未使用の区間辺を全て使う
+        while (true) {
+            int i = find_edge(find_edge, 1, 0, edge_size, upper[v], v);
+            if (i == NONE) break;
+            int y = edge_size + i;
+            right[y] = NONE;
+            for (y >>= 1; y >= 1; y >>= 1) right[y] = std::max(right[2 * y], right[2 * y + 1]);
+            int e = order[i];
+            fired_by[e] = v;
+            que.emplace(d + seg_edges[e].weight, e);
+        }
+    };
+
+    for (int s: source) {
+        assert(0 <= s && s < n);
+        if (dist[s] == Result::UNREACHABLE) settle(s, 0, NONE);
+    }
+    while (!que.empty()) {
+        auto [d, e] = que.top();
+        que.pop();
+        auto [c, r] = seg_edges[e].to;
+        for (int v = find_vertex(c); v < r; v = find_vertex(v + 1)) settle(v, d, fired_by[e]);
+    }
+
+    return Result(std::move(dist), std::move(parent));
+}
+
+///  # segment edge dijkstra(n, segment edges, source)
+///  単一始点
+///  O((n + m) log (n + m))
+template <class T>
+internal::DijkstraResult<T> segment_edge_dijkstra(int n, const std::vector<SegmentEdge<T>>& seg_edges, int source) {
+    return segment_edge_dijkstra(n, seg_edges, std::vector<int>{source});
+}
+
+}  //  namespace nono
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../ds/csr-array.hpp"
+#include "./base.hpp"
+#include "./bellman-ford.hpp"
+
+namespace nono {
+
+///  # spfa(n, edges, source)
+///  複数始点負辺ありの最短経路問題. bellman_ford と同じ結果を返す
+///  更新された頂点だけをdequeに積んで緩和する (SPFA)
+///  - SLF: 先頭より近ければ先頭に積む
+///  - LLL: 先頭が平均より遠ければ末尾に回す
+///  負閉路はTarjanの部分木解体で見つける
+///  最短路木を行きがけ順の連結リストで持ち, vを更新したらvの部分木を木から外す
+///  uからvを更新しようとしたときuがvの部分木にあれば負閉路で, vから到達できる頂点を
+///  全てINVALIDにして取り除いてから続ける
+///  最悪 O(nm) だが, 大抵はずっと速い
+template <class T>
+internal::BellmanFordResult<T> spfa(int n, const std::vector<EdgeBase<T>>& edges, const std::vector<int>& source) {
+    using Result = internal::BellmanFordResult<T>;
+    constexpr int NONE = -1;
+
+    std::vector<std::pair<int, std::pair<int, T>>> adjacency;
+    adjacency.reserve(edges.size());
+    for (const auto& e: edges) {
+        assert(0 <= e.from && e.from < n);
+        assert(0 <= e.to && e.to < n);
+        adjacency.push_back({e.from, {e.to, e.weight}});
+    }
+    const CSRArray<std::pair<int, T>> graph(n, adjacency);
+
+    std::vector<T> dist(n, Result::UNREACHABLE);
+    std::vector<int> parent(n, NONE);
+    std::vector<bool> invalid(n);
+    bool has_negative_cycle = false;
+
+    //  最短路木. 頂点nを根として, 行きがけ順に prev_/next_ で環状につなぐ
+    std::vector<int> prev(n + 1, n), next(n + 1, n), depth(n + 1);
+    std::vector<bool> in_tree(n + 1);
+    in_tree[n] = true;
+    auto unlink = [&](int x) {
+        next[prev[x]] = next[x];
+        prev[next[x]] = prev[x];
+        in_tree[x] = false;
+    };
+    auto link_after = [&](int p, int x) {
+        prev[x] = p;
+        next[x] = next[p];
+        prev[next[p]] = x;
+        next[p] = x;
+        depth[x] = depth[p] + 1;
+        in_tree[x] = true;
+    };
+
+    std::deque<int> que;
+    std::vector<bool> in_queue(n);
+    //  LLL用. dequeに入っている頂点の距離の和
+    long double sum = 0;
+    auto push = [&](int v) {
+        if (in_queue[v]) return;
+        in_queue[v] = true;
+        sum += dist[v];
+        if (!que.empty() && dist[v] < dist[que.front()]) {
+            que.push_front(v);
+        } else {
+            que.push_back(v);
+        }
+    };
+    auto pop = [&]() {
+        for (int i = que.size(); i > 1 && (long double)dist[que.front()] * que.size() > sum; i--) {
+            que.push_back(que.front());
+            que.pop_front();
+        }
+        int u = que.front();
+        que.pop_front();
+        in_queue[u] = false;
+        sum -= dist[u];
+        return u;
+    };
+
+    //  vから到達できる頂点を全て取り除く
+    std::vector<int> stack;
+    auto invalidate = [&](int v) {
+        has_negative_cycle = true;
+        invalid[v] = true;
+        stack.push_back(v);
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            if (in_tree[x]) unlink(x);
+            for (auto [y, w]: graph[x]) {
+                if (invalid[y]) continue;
+                invalid[y] = true;
+                stack.push_back(y);
+            }
+        }
+    };
+
+    for (int s: source) {
+        assert(0 <= s && s < n);
+        if (in_tree[s]) continue;
+        dist[s] = 0;
+        link_after(n, s);
+        push(s);
+    }
+    while (!que.empty()) {
+        int u = pop();
+        //  部分木ごと外されたものは, どうせ後で更新される
+        if (invalid[u] || !in_tree[u]) continue;
+        for (auto [v, w]: graph[u]) {
+            if (invalid[v]) continue;
+            T d = dist[u] + w;
+            if (dist[v] != Result::UNREACHABLE && dist[v] <= d) continue;
+            //  vの部分木を外す. uが含まれていれば負閉路
+            bool cycle = u == v;
+            if (in_tree[v]) {
+                int x = next[v];
+                while (depth[x] > depth[v]) {
+                    cycle |= x == u;
+                    int y = next[x];
+                    unlink(x);
+                    x = y;
+                }
+                unlink(v);
+            }
+            if (cycle) {
+                invalidate(v);
+                break;
+            }
+            if (in_queue[v]) sum -= dist[v] - d;
+            dist[v] = d;
+            parent[v] = u;
+            link_after(u, v);
+            push(v);
+        }
+    }
+
+    for (int v = 0; v < n; v++) {
+        if (invalid[v]) dist[v] = Result::INVALID;
+    }
+    return Result(std::move(dist), std::move(parent), has_negative_cycle);
+}
+
+///  # spfa(n, edges, source)
+///  単一始点
+template <class T>
+internal::BellmanFordResult<T> spfa(int n, const std::vector<EdgeBase<T>>& edges, int source) {
+    return spfa(n, edges, std::vector<int>{source});
+}
+
+}  //  namespace nono
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <vector>
 
+#include "../utility/parallel.hpp"
 #include "./base.hpp"
 
 namespace nono {
@@ -42,4 +45,65 @@ std::vector<int> topological_sort(const Graph<T>& graph) {
     return result;
 }
 
+///  # topological levels(graph, threads)
+///  入次数0の頂点から始めて, 入次数が0になった頂点の集まりを一段ずつ取り出す (段ごとのKahn)
+///  levels[i] := 入次数0の頂点からの最長路の辺数がiの頂点 (昇順)
+///  同じ段の頂点の間には辺がないので, 段ごとにまとめて処理できる
+///  if G is not DAG, return empty vector
+///
+///  threads > 1 なら各段をthreads個に分割し, 入次数をatomicに減らしながら並列に処理する
+///  結果はthreadsによらない
+///  O(V log V + E)
+template <class T>
+std::vector<std::vector<int>> topological_levels(const Graph<T>& graph, int threads = 1) {
+    assert(graph.is_directed());
+    assert(threads >= 1);
+    //  これより小さい段は一人で処理する
+    constexpr int PARALLEL_THRESHOLD = 1 << 12;
+    int n = graph.size();
+    std::vector<int> indegree(n);
+    for (int i = 0; i < n; i++) {
+        for (const auto& e: graph[i]) {
+            indegree[e.to]++;
+        }
+    }
+    std::vector<int> frontier;
+    for (int i = 0; i < n; i++) {
+        if (indegree[i] == 0) {
+            frontier.push_back(i);
+        }
+    }
+
+    //  スレッドごとの次の段
+    std::vector<std::vector<int>> next(threads);
+    std::vector<std::vector<int>> levels;
+    int visited = 0;
+    while (!frontier.empty()) {
+        visited += frontier.size();
+        const int size = frontier.size();
+        const int workers_size = size < PARALLEL_THRESHOLD ? 1 : threads;
+        internal::parallel_for(size, workers_size, [&](int id, int left, int right) {
+            auto& out = next[id];
+            out.clear();
+            for (int i = left; i < right; i++) {
+                for (const auto& e: graph[frontier[i]]) {
+                    if (workers_size == 1) {
+                        if (--indegree[e.to] == 0) out.push_back(e.to);
+                    } else {
+                        if (std::atomic_ref<int>(indegree[e.to]).fetch_sub(1, std::memory_order_relaxed) == 1) {
+                            out.push_back(e.to);
+                        }
+                    }
+                }
+            }
+        });
+        levels.push_back(std::move(frontier));
+        frontier.clear();
+        for (int id = 0; id < workers_size; id++) frontier.insert(frontier.end(), next[id].begin(), next[id].end());
+        std::sort(frontier.begin(), frontier.end());
+    }
+    if (visited != n) return {};
+    return levels;
+}
+
 }  //  namespace nono
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "../utility/parallel.hpp"
+
+namespace nono {
+
+namespace internal {
+
+//  ブロックの一辺. int なら一ブロック 16KB で, 三つ並べてもL2に収まる
+constexpr int MIN_PLUS_BLOCK = 64;
+
+//  min-plus積で「到達できない」を表す値. 二つ足してもオーバーフローしない
+template <class T>
+constexpr T MIN_PLUS_INF = std::numeric_limits<T>::max() / 2;
+
+///  # min_plus_block(c, c_stride, a, a_stride, b, b_stride)
+///  ブロック一つ分の c[i][j] <- min(c[i][j], min_k a[i][k] + b[k][j])
+///  a, b, c はそれぞれの stride 刻みの行優先で, どれも MIN_PLUS_BLOCK x MIN_PLUS_BLOCK
+///  値は MIN_PLUS_INF 以下で, MIN_PLUS_INF は ∞. ∞ を含む和は負の値と足しても ∞ のまま (MIN_PLUS_INF に丸める)
+///  cの行をローカルにコピーして更新するので, 最内ループは長さが定数で重なりもなく, -O2でもベクトル化される
+///  cとaが重なっていてもよく, そのときaからは更新前の値を読む (i行目のaはi行目を書き戻す前に全て読むため)
+///  cとbが重なっているときは, 先に書き戻した行 (k < i) をbとして更新後の値で読むことがある
+///  これは min をとるだけの閉包 (Floyd-Warshall) では正しいが, 一般のmin-plus積にはならない
+///  O(MIN_PLUS_BLOCK^3)
+template <class T>
+void min_plus_block(T* c, int c_stride, const T* a, int a_stride, const T* b, int b_stride) {
+    constexpr int B = MIN_PLUS_BLOCK;
+    T row[B];
+    for (int i = 0; i < B; i++) {
+        T* ci = c + (long long)i * c_stride;
+        const T* ai = a + (long long)i * a_stride;
+        std::copy(ci, ci + B, row);
+        for (int k = 0; k < B; k++) {
+            const T x = ai[k];
+            if (x >= MIN_PLUS_INF<T>) continue;
+            const T* bk = b + (long long)k * b_stride;
+            for (int j = 0; j < B; j++) {
+                row[j] = std::min(row[j], bk[j] >= MIN_PLUS_INF<T> ? MIN_PLUS_INF<T> : x + bk[j]);
+            }
+        }
+        std::copy(row, row + B, ci);
+    }
+}
+
+///  # pad_to_block(n)
+///  MIN_PLUS_BLOCK の倍数に切り上げる
+inline int pad_to_block(int n) {
+    return (n + MIN_PLUS_BLOCK - 1) / MIN_PLUS_BLOCK * MIN_PLUS_BLOCK;
+}
+
+}  //  namespace internal
+
+///  # min_plus_product(lhs, rhs, n, m, l, threads)
+///  (min, +) の行列積 result[i][j] = min_k lhs[i][k] + rhs[k][j]
+///  lhs は n x m, rhs は m x l, 結果は n x l で, どれも一次元の行優先
+///  ∞ は internal::MIN_PLUS_INF<T> (max / 2) 以上で表すこと. 負の値があってもよく, ∞ を含む和は ∞ になる
+///  結果の ∞ はちょうど MIN_PLUS_INF<T> なので, そのまま繰り返し掛けられる
+///  有限の値の和の絶対値は MIN_PLUS_INF<T> 未満であること
+///  キャッシュに載る大きさのブロックに分けて計算し, threads > 1 なら結果の行ブロックを分担する
+///  O(nml / threads)
+template <class T>
+std::vector<T> min_plus_product(const std::vector<T>& lhs, const std::vector<T>& rhs, int n, int m, int l,
+                                int threads = 1) {
+    assert(0 <= n && 0 <= m && 0 <= l);
+    assert(std::ssize(lhs) == (long long)n * m);
+    assert(std::ssize(rhs) == (long long)m * l);
+    assert(threads >= 1);
+    using internal::MIN_PLUS_BLOCK;
+    constexpr T INF = internal::MIN_PLUS_INF<T>;
+
+    //  各辺をブロックの倍数に揃え, はみ出した所はINFで埋める
+    const int rows = internal::pad_to_block(n);
+    const int mid = internal::pad_to_block(m);
+    const int columns = internal::pad_to_block(l);
+    std::vector<T> a((long long)rows * mid, INF);
+    std::vector<T> b((long long)mid * columns, INF);
+    std::vector<T> c((long long)rows * columns, INF);
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < m; k++) a[(long long)i * mid + k] = std::min(lhs[(long long)i * m + k], INF);
+    }
+    for (int k = 0; k < m; k++) {
+        for (int j = 0; j < l; j++) b[(long long)k * columns + j] = std::min(rhs[(long long)k * l + j], INF);
+    }
+
+    const int row_blocks = rows / MIN_PLUS_BLOCK;
+    const int mid_blocks = mid / MIN_PLUS_BLOCK;
+    const int column_blocks = columns / MIN_PLUS_BLOCK;
+    internal::parallel_for(row_blocks, threads, [&](int, int left, int right) {
+        for (int ib = left; ib < right; ib++) {
+            for (int kb = 0; kb < mid_blocks; kb++) {
+                for (int jb = 0; jb < column_blocks; jb++) {
+                    long long i = (long long)ib * MIN_PLUS_BLOCK, k = (long long)kb * MIN_PLUS_BLOCK,
+                              j = (long long)jb * MIN_PLUS_BLOCK;
+                    internal::min_plus_block(c.data() + i * columns + j, columns, a.data() + i * mid + k, mid,
+                                             b.data() + k * columns + j, columns);
+                }
+            }
+        }
+    });
+
+    std::vector<T> result((long long)n * l);
+    for (int i = 0; i < n; i++) {
+        std::copy(c.begin() + (long long)i * columns, c.begin() + (long long)i * columns + l,
+                  result.begin() + (long long)i * l);
+    }
+    return result;
+}
+
+}  //  namespace nono
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "../graph/base.hpp"
+#include "./is-tree.hpp"
+
+namespace nono {
+
+///  # CentroidDecomposition
+///  重心分解. 各頂点について, 重心木での祖先 (自分を含む) とそこまでの距離を持つ
+///  重心木の深さは O(log n) なので, 深さkの祖先と距離を ancestor_[k * n + v], dist_[k * n + v] の一次元配列で持つ
+///  「vから距離d以内の頂点数」「一番近い印のついた頂点」などは, vの祖先 c ごとに
+///  dist(v, k) と c に集めた値を使えば O(log n) で求まる
+template <class T>
+class CentroidDecomposition {
+    static constexpr int NONE = -1;
+
+  public:
+    ///  # CentroidDecomposition(graph)
+    ///  graphは無向の木
+    ///  成分ごとにBFSして大きさと重心を求めるので再帰しない
+    ///  O(n log n)
+    explicit CentroidDecomposition(const Graph<T>& graph): n_(graph.size()), depth_(n_), parent_(n_, NONE) {
+        if (n_ == 0) return;
+        assert(is_tree(graph));
+        std::vector<bool> removed(n_);
+        std::vector<int> bfs_parent(n_, NONE), size(n_);
+        std::vector<T> dist(n_);
+        std::vector<int> order;
+        order.reserve(n_);
+        //  重心木の深さは floor(log2 n) 以下
+        ancestor_.reserve((long long)std::bit_width((unsigned)n_) * n_);
+        dist_.reserve((long long)std::bit_width((unsigned)n_) * n_);
+
+        //  (成分の一頂点, 親の重心). 深さの浅い順に処理される
+        std::vector<std::pair<int, int>> components = {{0, NONE}};
+        for (int i = 0; i < std::ssize(components); i++) {
+            auto [start, parent] = components[i];
+            const int depth = parent == NONE ? 0 : depth_[parent] + 1;
+
+            //  成分をBFSして部分木の大きさを求める
+            order.assign(1, start);
+            bfs_parent[start] = NONE;
+            for (int j = 0; j < std::ssize(order); j++) {
+                int u = order[j];
+                for (const auto& e: graph[u]) {
+                    if (removed[e.to] || e.to == bfs_parent[u]) continue;
+                    bfs_parent[e.to] = u;
+                    order.push_back(e.to);
+                }
+            }
+            const int total = order.size();
+            for (int j = total - 1; j >= 0; j--) {
+                int u = order[j];
+                size[u] = 1;
+                for (const auto& e: graph[u]) {
+                    if (removed[e.to] || e.to == bfs_parent[u]) continue;
+                    size[u] += size[e.to];
+                }
+            }
+            //  大きさが半分を超える子がある間そちらへ進む
+            int centroid = start;
+            while (true) {
+                int next = NONE;
+                for (const auto& e: graph[centroid]) {
+                    if (removed[e.to] || e.to == bfs_parent[centroid]) continue;
+                    if (2 * size[e.to] > total) next = e.to;
+                }
+                if (next == NONE) break;
+                centroid = next;
+            }
+
+            //  重心から成分をBFSして距離を書き込む
+            if (depth == height_) {
+                height_++;
+                ancestor_.resize((long long)height_ * n_, NONE);
+                dist_.resize((long long)height_ * n_);
+            }
+            order.assign(1, centroid);
+            bfs_parent[centroid] = NONE;
+            dist[centroid] = 0;
+            for (int j = 0; j < std::ssize(order); j++) {
+                int u = order[j];
+                ancestor_[(long long)depth * n_ + u] = centroid;
+                dist_[(long long)depth * n_ + u] = dist[u];
+                for (const auto& e: graph[u]) {
+                    if (removed[e.to] || e.to == bfs_parent[u]) continue;
+                    bfs_parent[e.to] = u;
+                    dist[e.to] = dist[u] + e.weight;
+                    order.push_back(e.to);
+                }
+            }
+
+            depth_[centroid] = depth;
+            parent_[centroid] = parent;
+            if (parent == NONE) root_ = centroid;
+            removed[centroid] = true;
+            for (const auto& e: graph[centroid]) {
+                if (!removed[e.to]) components.emplace_back(e.to, centroid);
+            }
+        }
+    }
+
+    ///  # size()
+    ///  num of vertices
+    int size() const {
+        return n_;
+    }
+
+    ///  # root()
+    ///  重心木の根 (木全体の重心)
+    int root() const {
+        return root_;
+    }
+
+    ///  # height()
+    ///  重心木の深さの最大 + 1. O(log n)
+    int height() const {
+        return height_;
+    }
+
+    ///  # parent(v)
+    ///  重心木でのvの親. 根なら-1
+    ///  O(1)
+    int parent(int v) const {
+        assert(0 <= v && v < n_);
+        return parent_[v];
+    }
+
+    ///  # depth(v)
+    ///  重心木でのvの深さ. 根が0
+    ///  O(1)
+    int depth(int v) const {
+        assert(0 <= v && v < n_);
+        return depth_[v];
+    }
+
+    ///  # ancestor(v, k)
+    ///  重心木でのvの祖先のうち深さkのもの. ancestor(v, depth(v)) == v
+    ///  ancestor(v, k + 1) は, ancestor(v, k) を取り除いたときにvを含む成分の重心
+    ///  O(1)
+    int ancestor(int v, int k) const {
+        assert(0 <= v && v < n_);
+        assert(0 <= k && k <= depth_[v]);
+        return ancestor_[(long long)k * n_ + v];
+    }
+
+    ///  # dist(v, k)
+    ///  vと ancestor(v, k) の元の木での距離
+    ///  O(1)
+    T dist(int v, int k) const {
+        assert(0 <= v && v < n_);
+        assert(0 <= k && k <= depth_[v]);
+        return dist_[(long long)k * n_ + v];
+    }
+
+  private:
+    int n_;
+    int root_ = NONE;
+    int height_ = 0;
+    std::vector<int> depth_;
+    std::vector<int> parent_;
+    std::vector<int> ancestor_;
+    std::vector<T> dist_;
+};
+
+}  //  namespace nono
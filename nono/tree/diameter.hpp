@@ -67,22 +67,33 @@ internal::DiameterResult<T> diameter(const Graph<T>& graph) {
     using Result = internal::DiameterResult<T>;
     constexpr int NONE = -1;
 
-    std::vector<int> parent(graph.size());
-    std::vector<int> parent_edge(graph.size());
-    auto dfs = [&](auto&& self, int u, int p) -> std::pair<T, int> {
-        parent[u] = p;
-        std::pair<T, int> res = {0, u};
-        for (const auto& e: graph[u]) {
-            if (e.to == p) continue;
-            parent_edge[e.to] = e.id;
-            auto adj = self(self, e.to, u);
-            adj.first += e.weight;
-            res = std::max(res, adj);
+    int n = graph.size();
+    std::vector<int> parent(n);
+    std::vector<int> parent_edge(n);
+    std::vector<T> depth(n);
+    std::vector<int> order;
+    order.reserve(n);
+    //  (sourceからの距離, 頂点) の最大
+    auto farthest = [&](int source) -> std::pair<T, int> {
+        order.assign(1, source);
+        parent[source] = NONE;
+        depth[source] = 0;
+        std::pair<T, int> res = {0, source};
+        for (int i = 0; i < n; i++) {
+            int u = order[i];
+            res = std::max(res, {depth[u], u});
+            for (const auto& e: graph[u]) {
+                if (e.to == parent[u]) continue;
+                parent[e.to] = u;
+                parent_edge[e.to] = e.id;
+                depth[e.to] = depth[u] + e.weight;
+                order.push_back(e.to);
+            }
         }
         return res;
     };
-    std::pair<T, int> p1 = dfs(dfs, 0, NONE);
-    std::pair<T, int> p2 = dfs(dfs, p1.second, NONE);
+    std::pair<T, int> p1 = farthest(0);
+    std::pair<T, int> p2 = farthest(p1.second);
     const T dist = p2.first;
     std::array<int, 2> endpoints = {p2.second, p1.second};
     std::vector<int> vertex_id, edge_id;
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cassert>
+#include <utility>
 #include <vector>
 
 #include "../graph/base.hpp"
+#include "../utility/parallel.hpp"
 #include "./static-top-tree.hpp"
 
 namespace nono {
@@ -37,25 +40,31 @@ class DynamicTreeDP {
     using NodeType = static_top_tree::NodeType;
 
   public:
-    ///  # DynamicTreeDP(n, init, vertexs, edges, root)
+    ///  # DynamicTreeDP(n, init, vertexs, edges, root, threads)
     ///  init := 木構造を保持したやつ
     ///  vertexs := 頂点重み列
     ///  edges := 辺重み列
+    ///  static top tree のノードを高さの低い順に計算する. threads > 1 なら同じ高さのノードを分担する
     template <class T>
     DynamicTreeDP(int n, const std::vector<EdgeBase<T>>& init, const std::vector<Point>& vertexs,
-                  const std::vector<Edge>& edges, int root = 0)
+                  const std::vector<Edge>& edges, int root = 0, int threads = 1)
         : n_(n),
           stt_(to_static_top_tree(n, init, root)),
           tot_(stt_.nodes.size()),
           vertexs_(stt_.nodes.size()),
-          edges_(stt_.nodes.size()) {
+          edges_(stt_.nodes.size()),
+          dirty_(stt_.nodes.size()),
+          dirty_levels_(stt_.nodes[stt_.root].height + 1) {
+        assert(threads >= 1);
         for (int i = 0; i < n_; i++) {
             vertexs_[stt_.vertexs[i]] = vertexs[i];
         }
         for (int i = 0; i + 1 < n_; i++) {
             edges_[stt_.edges[i]] = edges[i];
         }
-        dfs(stt_.root);
+        std::vector<std::vector<int>> levels(dirty_levels_.size());
+        for (int u = 0; u < std::ssize(stt_.nodes); u++) levels[stt_.nodes[u].height].push_back(u);
+        for (const auto& level: levels) update_level(level, threads);
     }
 
     ///  # all_prod()
@@ -88,11 +97,52 @@ class DynamicTreeDP {
         }
     }
 
+    ///  # set_batch(vertexs, edges, threads)
+    ///  vertexs := (頂点番号, 値) の列
+    ///  edges := (辺番号, 値) の列
+    ///  まとめて書き換えてから, 値の変わったノードを高さの低い順に一度ずつ計算し直す
+    ///  同じ頂点, 辺が複数回あれば後のものになる
+    ///  O(変わったノード数) で, 一つずつ set するより共通の祖先の分だけ速い
+    void set_batch(const std::vector<std::pair<int, Point>>& vertexs, const std::vector<std::pair<int, Edge>>& edges,
+                   int threads = 1) {
+        assert(threads >= 1);
+        for (const auto& [i, point]: vertexs) {
+            assert(0 <= i && i < n_);
+            vertexs_[stt_.vertexs[i]] = point;
+            mark(stt_.vertexs[i]);
+        }
+        for (const auto& [i, edge]: edges) {
+            assert(0 <= i && i + 1 < n_);
+            edges_[stt_.edges[i]] = edge;
+            mark(stt_.edges[i]);
+        }
+        for (auto& level: dirty_levels_) {
+            update_level(level, threads);
+            for (int u: level) dirty_[u] = false;
+            level.clear();
+        }
+    }
+
   private:
-    void dfs(int u) {
-        if (stt_.nodes[u].left != -1) dfs(stt_.nodes[u].left);
-        if (stt_.nodes[u].right != -1) dfs(stt_.nodes[u].right);
-        update(u);
+    //  これより小さい段は一人で計算する
+    static constexpr int PARALLEL_THRESHOLD = 1 << 12;
+
+    //  uから根までを計算し直す対象にする. 既に印のある祖先より上は印がついている
+    void mark(int u) {
+        while (u != -1 && !dirty_[u]) {
+            dirty_[u] = true;
+            dirty_levels_[stt_.nodes[u].height].push_back(u);
+            u = stt_.nodes[u].parent;
+        }
+    }
+
+    //  高さの同じノードは互いの値を読まないので, 分担して計算できる
+    void update_level(const std::vector<int>& level, int threads) {
+        const int size = level.size();
+        const int workers_size = size < PARALLEL_THRESHOLD ? 1 : threads;
+        internal::parallel_for(size, workers_size, [&](int, int left, int right) {
+            for (int i = left; i < right; i++) update(level[i]);
+        });
     }
 
     void update(int u) {
@@ -121,6 +171,9 @@ class DynamicTreeDP {
     std::vector<Path> tot_;
     std::vector<Point> vertexs_;
     std::vector<Edge> edges_;
+    //  set_batch 用. 計算し直すノードの印と, それを高さごとに並べたもの
+    std::vector<bool> dirty_;
+    std::vector<std::vector<int>> dirty_levels_;
 };
 
 }  //  namespace nono
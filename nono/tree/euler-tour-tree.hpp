@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../structure/monoid.hpp"
+
+namespace nono {
+
+///  # EulerTourTree
+///  森に辺の追加 (link), 削除 (cut) をしながら, 部分木の値の積や頂点数を求める
+///  各木を Euler tour (頂点と向きつきの辺を訪れた順に並べた列) で持ち, 列をtreapで管理する
+///  根の変更は列の回転, link は列の連結, cut は列の切り出しになる
+///  treapのノードは一つの配列 (arena) に並べて番号で指し, 消した辺のノードは使い回す
+///  頂点ノードは 0, ..., n - 1 番, 辺ノードは (u, v), (v, u) (u < v) が n + 2k, n + 2k + 1 番の組
+///  辺 {u, v} -> k は最初に 2n 以上の大きさで確保した開番地法の表で引くので, 構築後は確保しない
+///  辺ノードだけが値 M::e() を持つ
+///  Mは可換であること
+///  各操作 expected O(log n)
+template <class M>
+class EulerTourTree {
+    using Value = M::Value;
+    static constexpr int NONE = -1;
+
+    struct Node {
+        int left = NONE;
+        int right = NONE;
+        int parent = NONE;
+        unsigned priority;
+        //  部分木のノード数, 頂点ノード数
+        int size = 1;
+        int vertices;
+        Value element;
+        Value total;
+    };
+
+  public:
+    EulerTourTree(): EulerTourTree(0) {}
+    explicit EulerTourTree(int n): EulerTourTree(std::vector<Value>(n, M::e())) {}
+    explicit EulerTourTree(const std::vector<Value>& value)
+        : n_(value.size()),
+          //  辺は高々 n - 1 本なので, 表の使用率は 1/2 以下
+          table_(std::bit_ceil(2u * std::max(n_, 1)), Slot{}),
+          shift_(64 - std::countr_zero(table_.size())) {
+        nodes_.resize(3 * n_);
+        free_.reserve(n_);
+        for (int v = 0; v < n_; v++) init_node(v, value[v]);
+        for (int k = n_ - 1; k >= 0; k--) free_.push_back(k);
+    }
+
+    ///  # size()
+    ///  num of vertices
+    int size() const {
+        return n_;
+    }
+
+    ///  # link(u, v)
+    ///  辺 (u, v) を追加する. uとvは別の木にあること
+    ///  列を環状に見て, uの直前に (u, v), vから始まる列, (v, u) を差し込む
+    ///  O(log n) expected
+    void link(int u, int v) {
+        assert(0 <= u && u < n_);
+        assert(0 <= v && v < n_);
+        assert(!connected(u, v));
+        int mhs = rotate(v);
+        auto [t, k] = locate(u);
+        auto [lhs, rhs] = split(t, k);
+        const auto [uv, vu] = new_edge(u, v);
+        merge(merge(merge(lhs, uv), merge(mhs, vu)), rhs);
+    }
+
+    ///  # cut(u, v)
+    ///  辺 (u, v) を削除する. 辺があること
+    ///  列を環状に見ると (u, v) と (v, u) の間がvの部分木なので, 根を変えずに
+    ///  A x B y C (x, y は二つの辺ノード) と分けて, B と C + A にする
+    ///  O(log n) expected
+    void cut(int u, int v) {
+        assert(0 <= u && u < n_);
+        assert(0 <= v && v < n_);
+        const int i = find(key(u, v));
+        assert(table_[i].key != EMPTY);
+        const int k = table_[i].edge;
+        erase(i);
+        free_.push_back(k);
+        int x = n_ + 2 * k, y = x + 1;
+        auto [top, px] = locate(x);
+        int py = locate(y).second;
+        if (px > py) {
+            std::swap(x, y);
+            std::swap(px, py);
+        }
+        auto [lhs, t] = split(top, px);
+        auto [mhs, rhs] = split(t, py - px + 1);
+        mhs = split(split(mhs, 1).second, py - px - 1).first;
+        merge(rhs, lhs);
+    }
+
+    ///  # reroot(v)
+    ///  vを根にする (vの列をvから始まるように回す)
+    ///  O(log n) expected
+    void reroot(int v) {
+        assert(0 <= v && v < n_);
+        rotate(v);
+    }
+
+    ///  # connected(u, v)
+    ///  同じ木にあるか
+    ///  O(log n) expected
+    bool connected(int u, int v) const {
+        assert(0 <= u && u < n_);
+        assert(0 <= v && v < n_);
+        return root(u) == root(v);
+    }
+
+    ///  # get(v)
+    ///  O(1)
+    Value get(int v) const {
+        assert(0 <= v && v < n_);
+        return nodes_[v].element;
+    }
+
+    ///  # set(v, value)
+    ///  vertex_v weight <- value
+    ///  O(log n) expected
+    void set(int v, Value value) {
+        assert(0 <= v && v < n_);
+        nodes_[v].element = value;
+        for (int x = v; x != NONE; x = nodes_[x].parent) update(x);
+    }
+
+    ///  # subtree_prod(v, p)
+    ///  pを親としたときのvの部分木の頂点の値の積. vとpは隣接していること
+    ///  O(log n) expected
+    Value subtree_prod(int v, int p) const {
+        return subtree_fold(v, p).first;
+    }
+
+    ///  # subtree_size(v, p)
+    ///  pを親としたときのvの部分木の頂点数. vとpは隣接していること
+    ///  O(log n) expected
+    int subtree_size(int v, int p) const {
+        return subtree_fold(v, p).second;
+    }
+
+    ///  # tree_prod(v)
+    ///  vを含む木の頂点の値の積
+    ///  O(log n) expected
+    Value tree_prod(int v) const {
+        assert(0 <= v && v < n_);
+        return nodes_[root(v)].total;
+    }
+
+    ///  # tree_size(v)
+    ///  vを含む木の頂点数
+    ///  O(log n) expected
+    int tree_size(int v) const {
+        assert(0 <= v && v < n_);
+        return nodes_[root(v)].vertices;
+    }
+
+  private:
+    static constexpr long long EMPTY = -1;
+
+    struct Slot {
+        long long key = EMPTY;
+        int edge;
+    };
+
+    int n_;
+    std::vector<Node> nodes_;
+    //  使っていない辺ノードの組の番号k
+    std::vector<int> free_;
+    //  辺 {u, v} -> 辺ノードの組の番号k. 線形探査で, 削除は後ろの要素を詰める
+    std::vector<Slot> table_;
+    int shift_;
+    std::mt19937 rng_{std::random_device{}()};
+
+    long long key(int u, int v) const {
+        if (u > v) std::swap(u, v);
+        return (long long)u * n_ + v;
+    }
+
+    int home(long long key) const {
+        return ((unsigned long long)key * 0x9e3779b97f4a7c15ull) >> shift_;
+    }
+
+    //  keyのある場所, なければ入れるべき空の場所
+    int find(long long key) const {
+        const int mask = table_.size() - 1;
+        int i = home(key);
+        while (table_[i].key != EMPTY && table_[i].key != key) i = (i + 1) & mask;
+        return i;
+    }
+
+    void erase(int i) {
+        const int mask = table_.size() - 1;
+        for (int j = (i + 1) & mask; table_[j].key != EMPTY; j = (j + 1) & mask) {
+            //  jの本来の場所が (i, j] の外なら, iに詰めても探索で見つかる
+            const int h = home(table_[j].key);
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                table_[i] = table_[j];
+                i = j;
+            }
+        }
+        table_[i].key = EMPTY;
+    }
+
+    void init_node(int x, Value value) {
+        Node& node = nodes_[x];
+        node = Node{};
+        node.priority = rng_();
+        node.vertices = x < n_;
+        node.element = node.total = value;
+    }
+
+    //  辺 (u, v) の辺ノードの組を取って表に入れ, ((u, v), (v, u)) のノードを返す
+    std::pair<int, int> new_edge(int u, int v) {
+        assert(!free_.empty());
+        const int k = free_.back();
+        free_.pop_back();
+        const long long uv = key(u, v);
+        const int i = find(uv);
+        assert(table_[i].key == EMPTY);
+        table_[i] = {uv, k};
+        const int x = n_ + 2 * k;
+        init_node(x, M::e());
+        init_node(x + 1, M::e());
+        return u < v ? std::pair{x, x + 1} : std::pair{x + 1, x};
+    }
+
+    int size(int x) const {
+        return x == NONE ? 0 : nodes_[x].size;
+    }
+
+    void update(int x) {
+        auto& node = nodes_[x];
+        node.size = 1;
+        node.vertices = x < n_;
+        node.total = node.element;
+        if (node.left != NONE) {
+            const auto& child = nodes_[node.left];
+            node.size += child.size;
+            node.vertices += child.vertices;
+            node.total = M::op(child.total, node.total);
+        }
+        if (node.right != NONE) {
+            const auto& child = nodes_[node.right];
+            node.size += child.size;
+            node.vertices += child.vertices;
+            node.total = M::op(node.total, child.total);
+        }
+    }
+
+    void set_left(int x, int child) {
+        nodes_[x].left = child;
+        if (child != NONE) nodes_[child].parent = x;
+    }
+
+    void set_right(int x, int child) {
+        nodes_[x].right = child;
+        if (child != NONE) nodes_[child].parent = x;
+    }
+
+    int root(int x) const {
+        while (nodes_[x].parent != NONE) x = nodes_[x].parent;
+        return x;
+    }
+
+    //  (xを含む列の根, xが列の何番目か). 一度登るだけで両方求める
+    std::pair<int, int> locate(int x) const {
+        int position = size(nodes_[x].left);
+        for (int p = nodes_[x].parent; p != NONE; x = p, p = nodes_[p].parent) {
+            if (nodes_[p].right == x) position += size(nodes_[p].left) + 1;
+        }
+        return {x, position};
+    }
+
+    //  列tを [0, k) と [k, |t|) に分ける. 返す列の根の親は NONE
+    std::pair<int, int> split(int t, int k) {
+        if (t == NONE) return {NONE, NONE};
+        nodes_[t].parent = NONE;
+        if (k <= size(nodes_[t].left)) {
+            auto [lhs, rhs] = split(nodes_[t].left, k);
+            set_left(t, rhs);
+            update(t);
+            return {lhs, t};
+        } else {
+            auto [lhs, rhs] = split(nodes_[t].right, k - size(nodes_[t].left) - 1);
+            set_right(t, lhs);
+            update(t);
+            return {t, rhs};
+        }
+    }
+
+    //  列lhsと列rhsをつなげる. 返す列の根の親は NONE
+    int merge(int lhs, int rhs) {
+        if (lhs == NONE) return rhs;
+        if (rhs == NONE) return lhs;
+        if (nodes_[lhs].priority > nodes_[rhs].priority) {
+            set_right(lhs, merge(nodes_[lhs].right, rhs));
+            update(lhs);
+            nodes_[lhs].parent = NONE;
+            return lhs;
+        } else {
+            set_left(rhs, merge(lhs, nodes_[rhs].left));
+            update(rhs);
+            nodes_[rhs].parent = NONE;
+            return rhs;
+        }
+    }
+
+    //  vから始まるように回し, 列の根を返す
+    int rotate(int v) {
+        auto [t, k] = locate(v);
+        auto [lhs, rhs] = split(t, k);
+        return merge(rhs, lhs);
+    }
+
+    //  列 t の [l, r) の (積, 頂点数). 書き換えずに根から降りる
+    std::pair<Value, int> fold(int t, int l, int r) const {
+        if (t == NONE || r <= 0 || size(t) <= l) return {M::e(), 0};
+        const auto& node = nodes_[t];
+        if (l <= 0 && size(t) <= r) return {node.total, node.vertices};
+        const int k = size(node.left);
+        auto [lhs, lhs_vertices] = fold(node.left, l, r);
+        if (l <= k && k < r) {
+            lhs = M::op(lhs, node.element);
+            lhs_vertices += t < n_;
+        }
+        auto [rhs, rhs_vertices] = fold(node.right, l - k - 1, r - k - 1);
+        return {M::op(lhs, rhs), lhs_vertices + rhs_vertices};
+    }
+
+    //  pを親としたときのvの部分木の (積, 頂点数)
+    //  列を環状に見ると, (p, v) の次から (v, p) の前までがvの部分木
+    std::pair<Value, int> subtree_fold(int v, int p) const {
+        assert(0 <= v && v < n_);
+        assert(0 <= p && p < n_);
+        const int i = find(key(p, v));
+        assert(table_[i].key != EMPTY);
+        const int x = n_ + 2 * table_[i].edge;
+        const auto [pv_node, vp_node] = p < v ? std::pair{x, x + 1} : std::pair{x + 1, x};
+        const auto [t, pv] = locate(pv_node);
+        const int l = pv + 1;
+        const int r = locate(vp_node).second;
+        if (l <= r) return fold(t, l, r);
+        //  列の端をまたぐ
+        auto [lhs, lhs_vertices] = fold(t, l, size(t));
+        auto [rhs, rhs_vertices] = fold(t, 0, r);
+        return {M::op(lhs, rhs), lhs_vertices + rhs_vertices};
+    }
+};
+
+}  //  namespace nono
@@ -29,8 +29,7 @@ class HeavyLightDecomposition {
           in_(n_),
           out_(n_) {
         assert(is_tree(graph_));
-        set_heavy_edge(0, NONE);
-        dfs(0, NONE, 0);
+        build();
     }
 
     int lowest_common_ancester(int u, int v) {
@@ -74,40 +73,57 @@ class HeavyLightDecomposition {
     }
 
   private:
-    int set_heavy_edge(int u, int p) {
-        int size_sum = 1;
-        int max_size = 0;
-        int max_size_i = 0;
-        auto&& adj = graph_[u];
-        for (int i = 0; i < std::ssize(adj); i++) {
-            const auto& e = adj[i];
-            if (e.to == p) continue;
-            int size = set_heavy_edge(e.to, u);
-            size_sum += size;
-            if (max_size < size) {
-                max_size = size;
-                max_size_i = i;
+    //  再帰せずに, 0からのBFS順に数回なめて作る
+    //  1. BFS順, 親, 深さ
+    //  2. 逆順に部分木の大きさ. 一番大きい子を隣接リストの先頭に移す (heavy edge)
+    //  3. BFS順に, 子に行きがけ順の番号を部分木の大きさずつずらして振る
+    void build() {
+        std::vector<int> order;
+        order.reserve(n_);
+        order.push_back(0);
+        for (int i = 0; i < n_; i++) {
+            int u = order[i];
+            for (const auto& e: graph_[u]) {
+                if (e.to == parent_[u]) continue;
+                parent_[e.to] = u;
+                depth_[e.to] = depth_[u] + 1;
+                order.push_back(e.to);
             }
         }
-        if (max_size_i != 0) {
-            std::swap(adj[0], adj[max_size_i]);
+
+        std::vector<int> size(n_, 1);
+        for (int i = n_ - 1; i >= 0; i--) {
+            int u = order[i];
+            auto&& adj = graph_[u];
+            int max_size = 0;
+            int max_size_i = 0;
+            for (int j = 0; j < std::ssize(adj); j++) {
+                const auto& e = adj[j];
+                if (e.to == parent_[u]) continue;
+                if (max_size < size[e.to]) {
+                    max_size = size[e.to];
+                    max_size_i = j;
+                }
+            }
+            if (max_size_i != 0) {
+                std::swap(adj[0], adj[max_size_i]);
+            }
+            if (parent_[u] != NONE) size[parent_[u]] += size[u];
         }
-        return size_sum;
-    }
 
-    int dfs(int u, int p, int now) {
-        parent_[u] = p;
-        in_[u] = now++;
-        bool heavy = true;
-        for (const auto& e: graph_[u]) {
-            if (e.to == p) continue;
-            head_[e.to] = (heavy ? head_[u] : e.to);
-            depth_[e.to] = depth_[u] + 1;
-            heavy = false;
-            now = dfs(e.to, u, now);
+        in_[0] = 0;
+        for (int u: order) {
+            out_[u] = in_[u] + size[u];
+            int now = in_[u] + 1;
+            bool heavy = true;
+            for (const auto& e: graph_[u]) {
+                if (e.to == parent_[u]) continue;
+                head_[e.to] = (heavy ? head_[u] : e.to);
+                heavy = false;
+                in_[e.to] = now;
+                now += size[e.to];
+            }
         }
-        out_[u] = now;
-        return now;
     }
 
     Interval subtree(int u, bool vertex) {
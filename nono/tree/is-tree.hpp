@@ -12,19 +12,21 @@ namespace nono {
 template <class T>
 bool is_tree(const Graph<T>& graph) {
     if (graph.is_directed()) return false;
-    constexpr int NONE = -1;
     int n = graph.size();
+    if (graph.edge_size() != n - 1) return false;
+    //  辺がn - 1本なら, 0から全部の頂点に届くことと木であることは同値
     std::vector<int> used(n);
-    auto dfs = [&](auto self, int u, int eid) -> bool {
-        used[u] = 1;
+    std::vector<int> stack = {0};
+    used[0] = 1;
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
         for (const auto& e: graph[u]) {
-            if (e.id == eid) continue;
-            if (used[e.to]) return false;
-            if (!self(self, e.to, e.id)) return false;
+            if (used[e.to]) continue;
+            used[e.to] = 1;
+            stack.push_back(e.to);
         }
-        return true;
-    };
-    if (!dfs(dfs, 0, NONE)) return false;
+    }
     return std::ranges::all_of(used, [](int f) { return f == 1; });
 }
 
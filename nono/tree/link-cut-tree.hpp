@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../structure/act-monoid.hpp"
+
+namespace nono {
+
+///  # LinkCutTree
+///  森に辺の追加 (link), 削除 (cut), 根の変更 (evert) をしながら, パス上の値の積を求める
+///  Mはact monoid. 作用が要らなければ act_monoid::ActMonoid<monoid> を使う
+///  各頂点は頂点番号をそのまま添字にした配列で持ち, 子や親も番号で指す
+///  各操作 amortized O(log n)
+template <class M>
+class LinkCutTree {
+    using Rev = act_monoid::Rev<M>;
+    using Value = M::Value;
+    using RevValue = Rev::Value;
+    using Act = M::Act;
+    static constexpr int NONE = -1;
+
+    struct Node {
+        int left = NONE;
+        int right = NONE;
+        //  splay木での親, splay木の根ならパスの上の頂点
+        int parent = NONE;
+        bool rev = false;
+        RevValue element;
+        RevValue total;
+        std::optional<Act> act;
+    };
+
+  public:
+    LinkCutTree(): LinkCutTree(0) {}
+    explicit LinkCutTree(int n): LinkCutTree(std::vector<Value>(n, M::e())) {}
+    explicit LinkCutTree(const std::vector<Value>& value): n_(value.size()), nodes_(n_) {
+        for (int v = 0; v < n_; v++) nodes_[v].element = nodes_[v].total = value[v];
+    }
+
+    ///  # size()
+    ///  num of vertices
+    int size() const {
+        return n_;
+    }
+
+    ///  # link(u, v)
+    ///  辺 (u, v) を追加する. uとvは別の木にあること
+    ///  O(log n) amortized
+    void link(int u, int v) {
+        assert(0 <= u && u < n_);
+        assert(0 <= v && v < n_);
+        assert(!connected(u, v));
+        evert(u);
+        expose(v);
+        nodes_[u].parent = v;
+    }
+
+    ///  # cut(u, v)
+    ///  辺 (u, v) を削除する. 辺があること
+    ///  O(log n) amortized
+    void cut(int u, int v) {
+        assert(0 <= u && u < n_);
+        assert(0 <= v && v < n_);
+        evert(u);
+        expose(v);
+        //  パスは u - v の二頂点だけ
+        assert(nodes_[v].left == u && nodes_[u].right == NONE);
+        nodes_[v].left = NONE;
+        nodes_[u].parent = NONE;
+        update(v);
+    }
+
+    ///  # evert(v)
+    ///  vを根にする
+    ///  O(log n) amortized
+    void evert(int v) {
+        assert(0 <= v && v < n_);
+        expose(v);
+        reverse(v);
+        push(v);
+    }
+
+    ///  # root(v)
+    ///  vを含む木の根
+    ///  O(log n) amortized
+    int root(int v) {
+        assert(0 <= v && v < n_);
+        expose(v);
+        while (true) {
+            push(v);
+            if (nodes_[v].left == NONE) break;
+            v = nodes_[v].left;
+        }
+        splay(v);
+        return v;
+    }
+
+    ///  # connected(u, v)
+    ///  同じ木にあるか
+    ///  O(log n) amortized
+    bool connected(int u, int v) {
+        return root(u) == root(v);
+    }
+
+    ///  # lca(u, v)
+    ///  今の根についてのlca. 別の木にあれば-1
+    ///  O(log n) amortized
+    int lca(int u, int v) {
+        if (!connected(u, v)) return NONE;
+        expose(u);
+        return expose(v);
+    }
+
+    ///  # get(v)
+    ///  O(log n) amortized
+    Value get(int v) {
+        assert(0 <= v && v < n_);
+        expose(v);
+        return nodes_[v].element.ord;
+    }
+
+    ///  # set(v, value)
+    ///  vertex_v weight <- value
+    ///  O(log n) amortized
+    void set(int v, Value value) {
+        assert(0 <= v && v < n_);
+        expose(v);
+        nodes_[v].element = value;
+        update(v);
+    }
+
+    ///  # prod path(u, v)
+    ///  u -> v のパス上の頂点の値を順に掛けたもの. uとvは同じ木にあること
+    ///  根はvになる
+    ///  O(log n) amortized
+    Value prod_path(int u, int v) {
+        assert(connected(u, v));
+        evert(u);
+        expose(v);
+        return nodes_[v].total.ord;
+    }
+
+    ///  # apply path(u, v, act)
+    ///  [for w in path(u, v)](w_weight <- mapping(act, w_weight))
+    ///  根はvになる
+    ///  O(log n) amortized
+    void apply_path(int u, int v, Act act) {
+        assert(connected(u, v));
+        evert(u);
+        expose(v);
+        apply(v, act);
+    }
+
+  private:
+    int n_;
+    std::vector<Node> nodes_;
+    //  splayで下ろす頂点を積む
+    std::vector<int> stack_;
+
+    bool is_root(int x) const {
+        int p = nodes_[x].parent;
+        return p == NONE || (nodes_[p].left != x && nodes_[p].right != x);
+    }
+
+    RevValue total(int x) const {
+        return x == NONE ? Rev::e() : nodes_[x].total;
+    }
+
+    void update(int x) {
+        nodes_[x].total = Rev::op(Rev::op(total(nodes_[x].left), nodes_[x].element), total(nodes_[x].right));
+    }
+
+    void reverse(int x) {
+        if (x == NONE) return;
+        auto& node = nodes_[x];
+        node.rev ^= true;
+        std::swap(node.total.ord, node.total.rev);
+        std::swap(node.left, node.right);
+    }
+
+    void apply(int x, Act act) {
+        if (x == NONE) return;
+        auto& node = nodes_[x];
+        node.element = Rev::mapping(act, node.element);
+        node.total = Rev::mapping(act, node.total);
+        node.act = Rev::composition(act, node.act ? *node.act : M::id());
+    }
+
+    void push(int x) {
+        auto& node = nodes_[x];
+        if (node.rev) {
+            reverse(node.left);
+            reverse(node.right);
+            node.rev = false;
+        }
+        if (node.act) {
+            apply(node.left, *node.act);
+            apply(node.right, *node.act);
+            node.act = std::nullopt;
+        }
+    }
+
+    void rotate(int x) {
+        int p = nodes_[x].parent;
+        int g = nodes_[p].parent;
+        if (nodes_[p].left == x) {
+            int c = nodes_[x].right;
+            nodes_[p].left = c;
+            if (c != NONE) nodes_[c].parent = p;
+            nodes_[x].right = p;
+        } else {
+            int c = nodes_[x].left;
+            nodes_[p].right = c;
+            if (c != NONE) nodes_[c].parent = p;
+            nodes_[x].left = p;
+        }
+        if (g != NONE) {
+            if (nodes_[g].left == p) nodes_[g].left = x;
+            if (nodes_[g].right == p) nodes_[g].right = x;
+        }
+        nodes_[p].parent = x;
+        nodes_[x].parent = g;
+        update(p);
+    }
+
+    //  xをsplay木の根にする. 上から遅延を下ろしてから回す
+    void splay(int x) {
+        stack_.clear();
+        for (int y = x;; y = nodes_[y].parent) {
+            stack_.push_back(y);
+            if (is_root(y)) break;
+        }
+        while (!stack_.empty()) {
+            push(stack_.back());
+            stack_.pop_back();
+        }
+        while (!is_root(x)) {
+            int p = nodes_[x].parent;
+            if (!is_root(p)) {
+                int g = nodes_[p].parent;
+                bool zigzig = (nodes_[g].left == p) == (nodes_[p].left == x);
+                rotate(zigzig ? p : x);
+            }
+            rotate(x);
+        }
+        update(x);
+    }
+
+    //  根からxまでをひとつのsplay木にし, xをその根にする
+    //  最後にsplay木をつなぎ替えた頂点を返す (直前にexposeした頂点とのlca)
+    int expose(int x) {
+        int last = NONE;
+        for (int y = x; y != NONE; y = nodes_[y].parent) {
+            splay(y);
+            nodes_[y].right = last;
+            update(y);
+            last = y;
+        }
+        splay(x);
+        return last;
+    }
+};
+
+}  //  namespace nono
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <utility>
 #include <vector>
 
@@ -15,6 +17,7 @@ namespace nono {
 ///  if edge base, EDGE = true
 ///
 ///  辺重みはコンストラクタで初期化できないので注意
+///  relabel = true なら頂点を行きがけ順に付け替える (Tree を参照). valueは元の番号で与える
 template <class M, class T, bool EDGE = false>
 class ProductableTree: public Tree<T> {
     using Rev = act_monoid::Rev<M>;
@@ -28,15 +31,18 @@ class ProductableTree: public Tree<T> {
     using Tree<T>::head_;
     using Tree<T>::depth_;
     using Tree<T>::parent_;
+    using Tree<T>::tour_;
+    using Tree<T>::n_;
 
   public:
     ProductableTree() {}
-    ProductableTree(int n, const std::vector<EdgeBase<T>>& edges, int root = 0)
-        : ProductableTree(n, edges, std::vector<Value>(n, M::e()), root) {}
-    ProductableTree(int n, const std::vector<EdgeBase<T>>& edges, const std::vector<Value>& value, int root = 0)
-        : Tree<T>(n, edges, root) {
+    ProductableTree(int n, const std::vector<EdgeBase<T>>& edges, int root = 0, bool relabel = false)
+        : ProductableTree(n, edges, std::vector<Value>(n, M::e()), root, relabel) {}
+    ProductableTree(int n, const std::vector<EdgeBase<T>>& edges, const std::vector<Value>& value, int root = 0,
+                    bool relabel = false)
+        : Tree<T>(n, edges, root, relabel) {
         std::vector<RevValue> rev_value(n);
-        for (int i = 0; i < n; i++) rev_value[in_[i]] = value[i];
+        for (int i = 0; i < n; i++) rev_value[in_[this->label(i)]] = value[i];
         segtree_ = LazySegmentTree<Rev>(rev_value);
     }
 
@@ -76,13 +82,30 @@ class ProductableTree: public Tree<T> {
     ///  [for w in path(u, v)](w_weight <- mapping(act, w_weight))
     ///  O((log n)^2)
     void apply_path(int lhs, int rhs, Act act) {
-        while (head_[lhs] != head_[rhs]) {
-            if (in_[lhs] > in_[rhs]) std::swap(lhs, rhs);
-            segtree_.apply(in_[head_[rhs]], in_[rhs] + 1, act);
-            rhs = parent_[head_[rhs]];
+        path_intervals(lhs, rhs, [&](int l, int r, bool) { segtree_.apply(l, r, act); });
+    }
+
+    ///  # apply path batch(paths, acts)
+    ///  apply_path(paths[i].first, paths[i].second, acts[i]) を i の順に行ったのと同じ
+    ///  BATCH 個ずつパスを区間に分け, 区間をheavy pathごとにまとめてから (同じheavy path内ではiの順) 作用させる
+    ///  同じheavy pathへの作用が続くので, 下ろす遅延のノードがキャッシュに乗ったままになる
+    ///  異なるheavy pathの区間は重ならないので, actが可換でなくても結果は変わらない
+    ///  O(q (log n)^2)
+    void apply_path_batch(const std::vector<std::pair<int, int>>& paths, const std::vector<Act>& acts) {
+        assert(paths.size() == acts.size());
+        std::vector<Interval> intervals;
+        for (int first = 0; first < std::ssize(paths); first += BATCH) {
+            const int last = std::min<int>(first + BATCH, paths.size());
+            intervals.clear();
+            for (int i = first; i < last; i++) {
+                path_intervals(paths[i].first, paths[i].second, [&](int l, int r, bool) {
+                    if (l < r) intervals.push_back({l, r, i});
+                });
+            }
+            for (int k: group_by_heavy_path(intervals)) {
+                segtree_.apply(intervals[k].left, intervals[k].right, acts[intervals[k].id]);
+            }
         }
-        if (in_[lhs] > in_[rhs]) std::swap(lhs, rhs);
-        segtree_.apply(in_[lhs] + EDGE, in_[rhs], act);
     }
 
     ///  # apply subtree(x, act)
@@ -98,23 +121,41 @@ class ProductableTree: public Tree<T> {
     Value prod_path(int from, int to) {
         Value sml = M::e();
         Value smr = M::e();
-        while (head_[from] != head_[to]) {
-            if (in_[from] > in_[to]) {
-                sml = M::op(sml, segtree_.prod(in_[head_[from]], in_[from] + 1).rev);
-                from = parent_[head_[from]];
+        path_intervals(from, to, [&](int l, int r, bool reversed) {
+            if (reversed) {
+                sml = M::op(sml, segtree_.prod(l, r).rev);
             } else {
-                smr = M::op(segtree_.prod(in_[head_[to]], in_[to] + 1).ord, smr);
-                to = parent_[head_[to]];
+                smr = M::op(segtree_.prod(l, r).ord, smr);
             }
-        }
-        if (in_[from] < in_[to]) {
-            smr = M::op(segtree_.prod(in_[from] + EDGE, in_[to] + 1).ord, smr);
-        } else {
-            sml = M::op(sml, segtree_.prod(in_[to] + EDGE, in_[from] + 1).rev);
-        }
+        });
         return M::op(sml, smr);
     }
 
+    ///  # prod path batch(paths)
+    ///  result[i] := prod_path(paths[i].first, paths[i].second)
+    ///  最初に遅延している作用を全て下ろしておき, 各区間では下ろさずに求める
+    ///  (区間を並べ替えてまとめるよりも, 下ろす手間が消える方がずっと効く)
+    ///  空でなければ毎回 O(n) 下ろすので, 作用のあるMで小さいbatchを何度も呼ぶと遅い. そのときは prod_path を使う
+    ///  O(n + q (log n)^2), paths が空なら O(1)
+    std::vector<Value> prod_path_batch(const std::vector<std::pair<int, int>>& paths) {
+        if (paths.empty()) return {};
+        segtree_.push_all();
+        std::vector<Value> result(paths.size());
+        for (int i = 0; i < std::ssize(paths); i++) {
+            Value sml = M::e();
+            Value smr = M::e();
+            path_intervals(paths[i].first, paths[i].second, [&](int l, int r, bool reversed) {
+                if (reversed) {
+                    sml = M::op(sml, segtree_.prod_pushed(l, r).rev);
+                } else {
+                    smr = M::op(segtree_.prod_pushed(l, r).ord, smr);
+                }
+            });
+            result[i] = M::op(sml, smr);
+        }
+        return result;
+    }
+
     ///  # prod subtree(x)
     ///  [for w in subtree(x)](w_weight <- mapping(act, w_weight))
     ///  O(log n)
@@ -123,7 +164,56 @@ class ProductableTree: public Tree<T> {
     }
 
   private:
+    //  batch系は一度にこれだけのクエリをまとめる
+    static constexpr int BATCH = 1 << 14;
+
     LazySegmentTree<Rev> segtree_;
+
+    struct Interval {
+        int left;
+        int right;
+        int id;
+    };
+
+    //  from -> to のパスを segment tree の区間に分けて, 順に emit(l, r, reversed) を呼ぶ
+    //  reversed := from側の区間 (根に向かって上る向き)
+    template <class F>
+    void path_intervals(int from, int to, F emit) {
+        while (head_[from] != head_[to]) {
+            if (in_[from] > in_[to]) {
+                emit(in_[head_[from]], in_[from] + 1, true);
+                from = parent_[head_[from]];
+            } else {
+                emit(in_[head_[to]], in_[to] + 1, false);
+                to = parent_[head_[to]];
+            }
+        }
+        if (in_[from] < in_[to]) {
+            emit(in_[from] + EDGE, in_[to] + 1, false);
+        } else {
+            emit(in_[to] + EDGE, in_[from] + 1, true);
+        }
+    }
+
+    //  区間の番号を, 属するheavy pathの先頭の位置で安定にソートして返す
+    //  11bitずつのLSD radix sort
+    std::vector<int> group_by_heavy_path(const std::vector<Interval>& intervals) {
+        constexpr int BITS = 11;
+        const int m = intervals.size();
+        std::vector<int> key(m), order(m), next(m);
+        for (int k = 0; k < m; k++) {
+            key[k] = in_[head_[tour_[intervals[k].left]]];
+            order[k] = k;
+        }
+        for (int shift = 0; (n_ - 1) >> shift > 0; shift += BITS) {
+            std::vector<int> start((1 << BITS) + 1);
+            for (int k: order) start[(key[k] >> shift & ((1 << BITS) - 1)) + 1]++;
+            for (int i = 0; i < (1 << BITS); i++) start[i + 1] += start[i];
+            for (int k: order) next[start[key[k] >> shift & ((1 << BITS) - 1)]++] = k;
+            std::swap(order, next);
+        }
+        return order;
+    }
 };
 
 }  //  namespace nono
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "../graph/base.hpp"
+#include "../utility/parallel.hpp"
 #include "./is-tree.hpp"
 
 namespace nono {
@@ -24,43 +25,95 @@ struct ReRootingInfoTemplate {
     Value add_vertex(Value vertex, Value value);
 };
 
-///  # rerooting(graph, vertex)
+///  # rerooting(graph, vertex, threads)
+///  再帰せずに, 0からのBFS順で二回なめる
+///  1. BFS順の逆に, 部分木のdp
+///  2. BFS順に, 親側の値を子に配る. 累積merge用の配列は担当ごとに一つを使い回す
+///  threads > 1 なら, BFS順を深さごとに区切って分担する
+///  同じ深さの頂点は互いの値を読まず, 書き込む先 (自分と子) も重ならない
 ///  O(n)
 template <class Info>
 std::vector<typename Info::Value> rerooting(const Graph<typename Info::Edge>& graph,
-                                            const std::vector<typename Info::Value>& vertex) {
+                                            const std::vector<typename Info::Value>& vertex, int threads = 1) {
     using Value = Info::Value;
     assert(is_tree(graph));
+    assert(threads >= 1);
+    //  これより少ない頂点しかない深さは一人で処理する
+    constexpr int PARALLEL_THRESHOLD = 1 << 12;
     int n = graph.size();
+    std::vector<int> parent(n, -1);
+    std::vector<int> order = {0};
+    order.reserve(n);
+    for (int i = 0; i < n; i++) {
+        int u = order[i];
+        for (const auto& e: graph[u]) {
+            if (e.to == parent[u]) continue;
+            parent[e.to] = u;
+            order.push_back(e.to);
+        }
+    }
+    //  order[level[d], level[d + 1]) が深さdの頂点. 一人なら全体で一区間
+    std::vector<int> level = {0};
+    if (threads > 1) {
+        std::vector<int> depth(n);
+        for (int i = 1; i < n; i++) {
+            depth[order[i]] = depth[parent[order[i]]] + 1;
+            if (depth[order[i]] != depth[order[i - 1]]) level.push_back(i);
+        }
+    }
+    level.push_back(n);
+
+    //  order[left, right) の頂点uに work(u, buffer) を呼ぶ. bufferは担当ごとの作業領域
+    //  reversed なら後ろから呼ぶ
+    std::vector<std::vector<Value>> buffers(threads);
+    auto parallel = [&](int left, int right, bool reversed, auto work) {
+        const int size = right - left;
+        const int workers_size = size < PARALLEL_THRESHOLD ? 1 : threads;
+        internal::parallel_for(size, workers_size, [&](int id, int l, int r) {
+            if (reversed) {
+                for (int i = left + r; i-- > left + l;) work(order[i], buffers[id]);
+            } else {
+                for (int i = left + l; i < left + r; i++) work(order[i], buffers[id]);
+            }
+        });
+    };
+
     std::vector<Value> dp(n, Info::e());
-    {
-        auto dfs = [&](auto&& self, int u, int p) -> Value {
+    for (int d = std::ssize(level) - 2; d >= 0; d--) {
+        parallel(level[d], level[d + 1], true, [&](int u, auto&) {
             Value value = Info::e();
-            for (auto e: graph[u]) {
-                if (e.to == p) continue;
-                value = Info::merge(value, Info::add_edge(e.weight, self(self, e.to, u)));
+            for (const auto& e: graph[u]) {
+                if (e.to == parent[u]) continue;
+                value = Info::merge(value, Info::add_edge(e.weight, dp[e.to]));
             }
-            return dp[u] = Info::add_vertex(vertex[u], value);
-        };
-        dfs(dfs, 0, -1);
+            dp[u] = Info::add_vertex(vertex[u], value);
+        });
     }
-    {
-        auto dfs = [&](auto&& self, int u, int p, Value p_value) -> void {
-            int m = graph[u].size();
-            std::vector<Value> prefix(m + 1, Info::e()), suffix(m + 1, Info::e());
-            for (int i = 0; auto e: graph[u]) {
-                prefix[i + 1] = suffix[i] = Info::add_edge(e.weight, e.to == p ? p_value : dp[e.to]);
-                i++;
+
+    //  p_value[u] := uの親を根とした, uを除く部分木のdp
+    std::vector<Value> p_value(n, Info::e());
+    for (int d = 0; d + 1 < std::ssize(level); d++) {
+        parallel(level[d], level[d + 1], false, [&](int u, std::vector<Value>& buffer) {
+            const auto& adj = graph[u];
+            const int m = adj.size();
+            if (std::ssize(buffer) < 2 * m + 1) buffer.resize(2 * m + 1, Info::e());
+            //  value[i] := i番目の辺の先の値, suffix[i] := value[i, m) のmerge
+            Value* value = buffer.data();
+            Value* suffix = buffer.data() + m;
+            suffix[m] = Info::e();
+            for (int i = m; i--;) {
+                const auto& e = adj[i];
+                value[i] = Info::add_edge(e.weight, e.to == parent[u] ? p_value[u] : dp[e.to]);
+                suffix[i] = Info::merge(value[i], suffix[i + 1]);
             }
-            for (int i = 0; i < m; i++) prefix[i + 1] = Info::merge(prefix[i], prefix[i + 1]);
-            for (int i = m; i--;) suffix[i] = Info::merge(suffix[i], suffix[i + 1]);
-            dp[u] = Info::add_vertex(vertex[u], prefix[m]);
-            for (int i = 0; auto e: graph[u]) {
-                if (e.to != p) self(self, e.to, u, Info::add_vertex(vertex[u], Info::merge(prefix[i], suffix[i + 1])));
-                i++;
+            Value prefix = Info::e();
+            for (int i = 0; i < m; i++) {
+                const auto& e = adj[i];
+                if (e.to != parent[u]) p_value[e.to] = Info::add_vertex(vertex[u], Info::merge(prefix, suffix[i + 1]));
+                prefix = Info::merge(prefix, value[i]);
             }
-        };
-        dfs(dfs, 0, -1, Info::e());
+            dp[u] = Info::add_vertex(vertex[u], prefix);
+        });
     }
     return dp;
 }
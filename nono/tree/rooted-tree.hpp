@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <utility>
 #include <vector>
 
@@ -16,16 +17,21 @@ template <class T>
 Graph<T> to_rooted_tree(int n, std::vector<EdgeBase<T>> edges, int root = 0) {
     auto graph = to_undirected_graph(n, edges);
     assert(is_tree(graph));
-    auto dfs = [&](auto&& self, int u, int p) -> void {
-        for (auto e: graph[u]) {
-            if (e.to == p) continue;
+    //  rootからBFSして, 親から子への向きに揃える
+    std::vector<int> parent(n, -1);
+    std::vector<int> order = {root};
+    order.reserve(n);
+    for (int i = 0; i < std::ssize(order); i++) {
+        int u = order[i];
+        for (const auto& e: graph[u]) {
+            if (e.to == parent[u]) continue;
+            parent[e.to] = u;
             if (edges[e.id].to != e.to) {
                 std::swap(edges[e.id].from, edges[e.id].to);
             }
-            self(self, e.to, u);
+            order.push_back(e.to);
         }
-    };
-    dfs(dfs, root, -1);
+    }
     return to_directed_graph(n, edges);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -87,6 +88,8 @@ struct Node {
     int left;
     int right;
     int parent;
+    //  葉を0とした高さ. 高さの同じノードは互いに祖先にならない
+    int height;
 };
 
 }  //  namespace static_top_tree
@@ -112,7 +115,7 @@ class StaticTopTreeBuilder {
           vertexs_(n),
           edges_(n - 1) {
         assert(is_tree(to_undirected_graph(n, edges)));
-        dfs(root);
+        set_heavy_child(root);
         root_ = compress(root).first;
     }
 
@@ -121,24 +124,32 @@ class StaticTopTreeBuilder {
     }
 
   private:
-    int dfs(int u) {
-        int size_sum = 1;
-        int max_size = 0;
-        int max_size_i = 0;
-        auto&& adj = graph_[u];
-        for (int i = 0; i < std::ssize(adj); i++) {
-            const auto& e = adj[i];
-            int size = dfs(e.to);
-            size_sum += size;
-            if (max_size < size) {
-                max_size = size;
-                max_size_i = i;
-            }
+    //  各頂点の子のうち部分木が最大のものを先頭に持ってくる
+    //  BFS順を逆から見て部分木の大きさを求めるので再帰しない
+    void set_heavy_child(int root) {
+        std::vector<int> order = {root};
+        order.reserve(n_);
+        for (int i = 0; i < std::ssize(order); i++) {
+            for (const auto& e: graph_[order[i]]) order.push_back(e.to);
         }
-        if (max_size_i != 0) {
-            std::swap(adj[0], adj[max_size_i]);
+        std::vector<int> size(n_, 1);
+        for (int i = n_ - 1; i >= 0; i--) {
+            int u = order[i];
+            int max_size = 0;
+            int max_size_i = 0;
+            auto&& adj = graph_[u];
+            for (int j = 0; j < std::ssize(adj); j++) {
+                int s = size[adj[j].to];
+                size[u] += s;
+                if (max_size < s) {
+                    max_size = s;
+                    max_size_i = j;
+                }
+            }
+            if (max_size_i != 0) {
+                std::swap(adj[0], adj[max_size_i]);
+            }
         }
-        return size_sum;
     }
 
     //  (sst vertex, size)
@@ -210,13 +221,16 @@ class StaticTopTreeBuilder {
 
     int add(int left, int right, NodeType type) {
         int id = nodes_.size();
+        int height = 0;
         if (left != -1) {
             nodes_[left].parent = id;
+            height = std::max(height, nodes_[left].height + 1);
         }
         if (right != -1) {
             nodes_[right].parent = id;
+            height = std::max(height, nodes_[right].height + 1);
         }
-        nodes_.push_back({type, left, right, -1});
+        nodes_.push_back({type, left, right, -1, height});
         return id;
     }
 
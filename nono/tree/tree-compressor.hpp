@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -22,15 +23,30 @@ struct TreeCompressResult {
     std::vector<int> mapping;
 };
 
-}  //  namespace internal
-
-///  # Tree Compressor
-///  "指定された頂点たちの最小共通祖先関係を保って木を圧縮してできる補助的な木" を作るやつ
-///  Weighted版もある
+///  # TreeCompressView
+///  compress_view の結果. 圧縮後の頂点は元の木の行きがけ順に並び, 0が根
+///  compressor の中の作業領域を指すので, 次に compress_view を呼ぶまで有効
+///  mapping[i] := 圧縮後の頂点i -> 元の頂点
+///  parent[i] := 圧縮後の木でのiの親 (< i). 根は-1
+///  weight[i] := 元の木での mapping[i] と mapping[parent[i]] の距離 (辺重みの和). 根は0
+///  親が前にあるので, 前から回せば根から, 後ろから回せば葉からのdpになる
 template <class T>
-class TreeCompressor {
-    using Result = internal::TreeCompressResult<T>;
+struct TreeCompressView {
+    std::span<const int> mapping;
+    std::span<const int> parent;
+    std::span<const T> weight;
 
+    int size() const {
+        return mapping.size();
+    }
+};
+
+///  # TreeCompressorBase
+///  TreeCompressor, WeightedTreeCompressor の共通部分
+///  行きがけ順の番号で x < y なら, lca は (x, y] で深さが最小の頂点の親
+///  (深さ, 親) の sparse table で O(1) で引く
+template <class T>
+class TreeCompressorBase {
     struct Min_ {
         using Value = std::pair<int, int>;
         static Value op(Value lhs, Value rhs) {
@@ -41,160 +57,200 @@ class TreeCompressor {
         }
     };
 
-  public:
-    ///  # TreeCompressor(graph)
-    ///  O(n log n)
-    TreeCompressor(const Graph<T>& graph): in_(graph.size()), out_(graph.size()) {
+  protected:
+    //  再帰せずに行きがけ順を作る. 子は隣接リストの順に訪れる
+    //  頂点番号を行きがけ順の番号に直したら, 後は全て行きがけ順の番号で引く
+    //  O(n log n)
+    TreeCompressorBase(const Graph<T>& graph)
+        : in_(graph.size()),
+          end_(graph.size()),
+          tour_(graph.size()),
+          weighted_depth_(graph.size()) {
         assert(is_tree(graph));
-        int n = graph.size();
-        std::vector<std::pair<int, int>> depth_index_pairs(2 * n);
+        const int n = graph.size();
+        //  parent[i], depth[i] := 行きがけ順でi番目の頂点の親の番号, 深さ
+        std::vector<int> parent(n, -1), depth(n);
+        std::vector<std::pair<int, int>> stack = {{0, -1}};
         int now = 0;
-        auto dfs = [&](auto self, int u, int p, int d) -> void {
-            in_[u] = now;
-            depth_index_pairs[now] = {d, u};
-            now++;
-            for (const auto& e: graph[u]) {
+        while (!stack.empty()) {
+            auto [u, p] = stack.back();
+            stack.pop_back();
+            const int i = now++;
+            in_[u] = i;
+            tour_[i] = u;
+            if (p != -1) {
+                parent[i] = in_[p];
+                depth[i] = depth[in_[p]] + 1;
+            }
+            const auto& adj = graph[u];
+            for (int j = std::ssize(adj) - 1; j >= 0; j--) {
+                const auto& e = adj[j];
                 if (e.to == p) continue;
-                self(self, e.to, u, d + 1);
-                depth_index_pairs[now] = {d, u};
-                now++;
+                stack.emplace_back(e.to, u);
             }
-            out_[u] = now;
-        };
-        dfs(dfs, 0, -1, 0);
-        table_ = SparseTable<Min_>(depth_index_pairs);
+        }
+        std::vector<T> parent_weight(n);
+        for (int u = 0; u < n; u++) {
+            for (const auto& e: graph[u]) {
+                if (in_[e.to] > in_[u]) parent_weight[in_[e.to]] = e.weight;
+            }
+        }
+        for (int i = 1; i < n; i++) weighted_depth_[i] = weighted_depth_[parent[i]] + parent_weight[i];
+        for (int i = 0; i < n; i++) end_[i] = i + 1;
+        for (int i = n - 1; i > 0; i--) end_[parent[i]] = std::max(end_[parent[i]], end_[i]);
+        std::vector<std::pair<int, int>> depth_parent_pairs(n);
+        for (int i = 0; i < n; i++) depth_parent_pairs[i] = {depth[i], parent[i]};
+        table_ = SparseTable<Min_>(std::move(depth_parent_pairs));
     }
 
-    ///  # compress(vertices)
-    ///  verticesに含まれる頂点の祖先関係を保ったtreeを作る
-    ///  O(|v| log |v|)
-    Result compress(std::vector<int> vertices) const {
-        std::ranges::sort(vertices, [&](int lhs, int rhs) { return in_[lhs] < in_[rhs]; });
-        for (int i = 0, n = vertices.size(); i + 1 < n; i++) vertices.push_back(lca(vertices[i], vertices[i + 1]));
-        std::ranges::sort(vertices, [&](int lhs, int rhs) { return in_[lhs] < in_[rhs]; });
-        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
-        int n = vertices.size();
+    //  compress の作業領域
+    struct Workspace {
+        std::vector<int> order;
+        std::vector<int> mapping;
+        std::vector<int> parent;
+        std::vector<T> weight;
         std::vector<int> stack;
-        std::vector<Edge> edges;
-        stack.push_back(0);
-        for (int i = 1; i < n; i++) {
-            int u = vertices[i];
-            while (!stack.empty()) {
-                int v = vertices[stack.back()];
-                if (out_[u] < out_[v]) break;
-                stack.pop_back();
-            }
-            assert(!stack.empty());
-            edges.emplace_back(stack.back(), i);
+    };
+
+    //  verticesから圧縮した木を workspace に作る
+    //  作業領域の大きさが足りていれば確保はしない
+    //  O(|v| log |v|)
+    void build(const std::vector<int>& vertices, Workspace& workspace) const {
+        assert(!vertices.empty());
+        //  頂点ではなく行きがけ順の番号を並べる
+        auto& order = workspace.order;
+        order.clear();
+        order.reserve(2 * vertices.size());
+        for (int v: vertices) order.push_back(in_[v]);
+        std::ranges::sort(order);
+        for (int i = 0, n = order.size(); i + 1 < n; i++) order.push_back(lca(order[i], order[i + 1]));
+        std::ranges::sort(order);
+        order.erase(std::unique(order.begin(), order.end()), order.end());
+
+        const int n = order.size();
+        auto& mapping = workspace.mapping;
+        auto& parent = workspace.parent;
+        auto& weight = workspace.weight;
+        auto& stack = workspace.stack;
+        mapping.resize(n);
+        parent.resize(n);
+        weight.resize(n);
+        stack.clear();
+        stack.reserve(n);
+        for (int i = 0; i < n; i++) {
+            const int x = order[i];
+            mapping[i] = tour_[x];
+            while (!stack.empty() && end_[order[stack.back()]] <= x) stack.pop_back();
+            assert(i == 0 || !stack.empty());
+            parent[i] = stack.empty() ? -1 : stack.back();
+            weight[i] = stack.empty() ? T{} : weighted_depth_[x] - weighted_depth_[order[stack.back()]];
             stack.push_back(i);
         }
-        assert((int)edges.size() == n - 1);
-        return Result(to_undirected_graph(n, edges), vertices);
+    }
+
+    static TreeCompressView<T> view(const Workspace& workspace) {
+        return {workspace.mapping, workspace.parent, workspace.weight};
     }
 
   private:
-    int lca(int u, int v) const {
-        if (in_[u] <= in_[v] && out_[v] <= out_[u]) return u;
-        if (in_[v] <= in_[u] && out_[u] <= out_[v]) return v;
-        if (in_[u] > in_[v]) std::swap(u, v);
-        assert(out_[u] < in_[v] + 1);
-        return table_.prod(out_[u], in_[v] + 1).second;
+    //  行きがけ順の番号 x < y の lca の番号
+    int lca(int x, int y) const {
+        if (x == y) return x;
+        return table_.prod(x + 1, y + 1).second;
     }
 
+    //  in_[u] := 頂点uの行きがけ順の番号
+    //  以下は行きがけ順の番号で引く. end_[x] := xの部分木の終わり, tour_[x] := 元の頂点
     std::vector<int> in_;
-    std::vector<int> out_;
+    std::vector<int> end_;
+    std::vector<int> tour_;
+    std::vector<T> weighted_depth_;
     SparseTable<Min_> table_;
 };
 
+}  //  namespace internal
+
 ///  # Tree Compressor
 ///  "指定された頂点たちの最小共通祖先関係を保って木を圧縮してできる補助的な木" を作るやつ
-///  辺重みが縮約された辺重みの総和
+///  Weighted版もある
 template <class T>
-class WeightedTreeCompressor {
+class TreeCompressor: internal::TreeCompressorBase<T> {
+    using Base = internal::TreeCompressorBase<T>;
     using Result = internal::TreeCompressResult<T>;
-
-    struct Min_ {
-        using Value = std::pair<int, int>;
-        static Value op(Value lhs, Value rhs) {
-            return std::min(lhs, rhs);
-        }
-        static Value e() {
-            return {1e9, 1e9};
-        }
-    };
+    using View = internal::TreeCompressView<T>;
 
   public:
     ///  # TreeCompressor(graph)
     ///  O(n log n)
-    WeightedTreeCompressor(const Graph<T>& graph)
-        : in_(graph.size()),
-          out_(graph.size()),
-          weighted_depth_(graph.size()) {
-        assert(is_tree(graph));
-        int n = graph.size();
-        std::vector<std::pair<int, int>> depth_index_pairs(2 * n);
-        int now = 0;
-        auto dfs = [&](auto self, int u, int p, int d, T weighted_d) -> void {
-            in_[u] = now;
-            weighted_depth_[u] = weighted_d;
-            depth_index_pairs[now] = {d, u};
-            now++;
-            for (const auto& e: graph[u]) {
-                if (e.to == p) continue;
-                self(self, e.to, u, d + 1, weighted_d + e.weight);
-                depth_index_pairs[now] = {d, u};
-                now++;
-            }
-            out_[u] = now;
-        };
-        dfs(dfs, 0, -1, 0, T{});
-        table_ = SparseTable<Min_>(depth_index_pairs);
-    }
+    TreeCompressor(const Graph<T>& graph): Base(graph) {}
 
     ///  # compress(vertices)
     ///  verticesに含まれる頂点の祖先関係を保ったtreeを作る
     ///  O(|v| log |v|)
-    Result compress(std::vector<int> vertices) const {
-        std::ranges::sort(vertices, [&](int lhs, int rhs) { return in_[lhs] < in_[rhs]; });
-        for (int i = 0, n = vertices.size(); i + 1 < n; i++) vertices.push_back(lca(vertices[i], vertices[i + 1]));
-        std::ranges::sort(vertices, [&](int lhs, int rhs) { return in_[lhs] < in_[rhs]; });
-        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
-        int n = vertices.size();
-        std::vector<int> stack;
-        std::vector<WeightedEdge<T>> edges;
-        stack.push_back(0);
-        for (int i = 1; i < n; i++) {
-            int u = vertices[i];
-            while (!stack.empty()) {
-                int v = vertices[stack.back()];
-                if (out_[u] < out_[v]) break;
-                stack.pop_back();
-            }
-            assert(!stack.empty());
-            edges.emplace_back(stack.back(), i, distance(vertices[stack.back()], vertices[i]));
-            stack.push_back(i);
-        }
-        assert((int)edges.size() == n - 1);
-        return Result(to_undirected_graph(n, edges), vertices);
+    Result compress(const std::vector<int>& vertices) const {
+        typename Base::Workspace workspace;
+        this->build(vertices, workspace);
+        int n = workspace.mapping.size();
+        std::vector<Edge> edges;
+        edges.reserve(n - 1);
+        for (int i = 1; i < n; i++) edges.emplace_back(workspace.parent[i], i);
+        return Result(to_undirected_graph(n, edges), std::move(workspace.mapping));
+    }
+
+    ///  # compress_view(vertices)
+    ///  compress と同じ木を, Graph を作らずに (mapping, parent, weight) の配列で返す
+    ///  weight は元の木での辺の本数 (Tが辺重みならその和)
+    ///  作業領域を使い回すので, 何度も呼んでも確保は最初の数回だけ
+    ///  次に呼ぶまで有効
+    ///  O(|v| log |v|)
+    View compress_view(const std::vector<int>& vertices) {
+        this->build(vertices, workspace_);
+        return Base::view(workspace_);
     }
 
   private:
-    int lca(int u, int v) const {
-        if (in_[u] <= in_[v] && out_[v] <= out_[u]) return u;
-        if (in_[v] <= in_[u] && out_[u] <= out_[v]) return v;
-        if (in_[u] > in_[v]) std::swap(u, v);
-        assert(out_[u] < in_[v] + 1);
-        return table_.prod(out_[u], in_[v] + 1).second;
+    Base::Workspace workspace_;
+};
+
+///  # Tree Compressor
+///  "指定された頂点たちの最小共通祖先関係を保って木を圧縮してできる補助的な木" を作るやつ
+///  辺重みが縮約された辺重みの総和
+template <class T>
+class WeightedTreeCompressor: internal::TreeCompressorBase<T> {
+    using Base = internal::TreeCompressorBase<T>;
+    using Result = internal::TreeCompressResult<T>;
+    using View = internal::TreeCompressView<T>;
+
+  public:
+    ///  # TreeCompressor(graph)
+    ///  O(n log n)
+    WeightedTreeCompressor(const Graph<T>& graph): Base(graph) {}
+
+    ///  # compress(vertices)
+    ///  verticesに含まれる頂点の祖先関係を保ったtreeを作る
+    ///  O(|v| log |v|)
+    Result compress(const std::vector<int>& vertices) const {
+        typename Base::Workspace workspace;
+        this->build(vertices, workspace);
+        int n = workspace.mapping.size();
+        std::vector<WeightedEdge<T>> edges;
+        edges.reserve(n - 1);
+        for (int i = 1; i < n; i++) edges.emplace_back(workspace.parent[i], i, workspace.weight[i]);
+        return Result(to_undirected_graph(n, edges), std::move(workspace.mapping));
     }
 
-    T distance(int u, int v) const {
-        return weighted_depth_[v] - weighted_depth_[u];
+    ///  # compress_view(vertices)
+    ///  compress と同じ木を, Graph を作らずに (mapping, parent, weight) の配列で返す
+    ///  作業領域を使い回すので, 何度も呼んでも確保は最初の数回だけ
+    ///  次に呼ぶまで有効
+    ///  O(|v| log |v|)
+    View compress_view(const std::vector<int>& vertices) {
+        this->build(vertices, workspace_);
+        return Base::view(workspace_);
     }
 
-    std::vector<int> in_;
-    std::vector<int> out_;
-    std::vector<T> weighted_depth_;
-    SparseTable<Min_> table_;
+  private:
+    Base::Workspace workspace_;
 };
 
 }  //  namespace nono
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
 #include <utility>
 #include <vector>
 
@@ -13,11 +15,15 @@ namespace nono {
 
 ///  # Tree
 ///  graph + lca + la + jump + dist + depth + height + centroid + diameter ...
+///
+///  relabel = true なら, 頂点を行きがけ順 (HLDの順) の番号に付け替える
+///  根は0になり, heavy path と部分木は連続した番号になる. 隣接リストもその順に並べ直す
+///  以降は全て新しい番号で扱う. 対応は label(x), original(x) で引ける
 template <class T>
 class Tree: public Graph<T> {
   public:
     Tree() {}
-    Tree(int n, const std::vector<EdgeBase<T>>& edges, int root = 0)
+    Tree(int n, const std::vector<EdgeBase<T>>& edges, int root = 0, bool relabel = false)
         : Graph<T>(to_undirected_graph(n, edges)),
           n_(n),
           root_(root),
@@ -30,14 +36,129 @@ class Tree: public Graph<T> {
           head_(n_, root_),
           parent_(n_, -1) {
         assert(is_tree(*this));
-        set_heavy_edge(root_, -1);
-        dfs(root_, -1, 0);
+        build();
+        if (relabel) relabel_vertices(edges);
     }
+
+    ///  # label(x)
+    ///  元の頂点xの新しい番号. 付け替えていなければx
+    ///  O(1)
+    int label(int x) const {
+        assert(0 <= x && x < n_);
+        return label_.empty() ? x : label_[x];
+    }
+
+    ///  # original(x)
+    ///  新しい番号xの元の頂点. 付け替えていなければx
+    ///  O(1)
+    int original(int x) const {
+        assert(0 <= x && x < n_);
+        return original_.empty() ? x : original_[x];
+    }
+
+    ///  # labels()
+    ///  labels()[x] := 元の頂点xの新しい番号. 付け替えていなければ空
+    const std::vector<int>& labels() const {
+        return label_;
+    }
+
+    ///  # originals()
+    ///  originals()[x] := 新しい番号xの元の頂点. 付け替えていなければ空
+    const std::vector<int>& originals() const {
+        return original_;
+    }
+
+    ///  # build_lca_table()
+    ///  これを呼ぶと lca, dist, weighted_dist が O(1) になる
+    ///  行きがけ順で in(u) < in(v) なら, lca(u, v) は (in(u), in(v)] で深さが最小の頂点の親
+    ///  (Euler tour の代わりに行きがけ順を使うので長さはn)
+    ///  区間最小は64個ずつのブロックに分け, ブロック内はビットマスク, ブロック間はsparse tableで引く
+    ///  O(n) time, O(n) memory
+    void build_lca_table() {
+        constexpr int B = 64;
+        const int blocks = (n_ + B - 1) / B;
+        rmq_mask_.assign(n_, 0);
+        for (int start = 0; start < n_; start += B) {
+            //  ブロック内で, 後ろのどの値よりも深さが小さい位置の集合 (単調stack)
+            unsigned long long mask = 0;
+            for (int i = start; i < std::min(start + B, n_); i++) {
+                while (mask != 0) {
+                    int top = start + std::bit_width(mask) - 1;
+                    if (depth_[tour_[top]] <= depth_[tour_[i]]) break;
+                    mask ^= 1ULL << (top - start);
+                }
+                mask |= 1ULL << (i - start);
+                rmq_mask_[i] = mask;
+            }
+        }
+        const int levels = std::bit_width((unsigned)blocks);
+        rmq_blocks_ = blocks;
+        rmq_table_.assign((long long)levels * blocks, 0);
+        for (int b = 0; b < blocks; b++) rmq_table_[b] = block_argmin(b * B, std::min(b * B + B, n_) - 1);
+        for (int h = 1; h < levels; h++) {
+            const int* prev = rmq_table_.data() + (long long)(h - 1) * blocks;
+            int* next = rmq_table_.data() + (long long)h * blocks;
+            for (int b = 0; b + (1 << h) <= blocks; b++) next[b] = shallower(prev[b], prev[b + (1 << (h - 1))]);
+        }
+    }
+
+    ///  # build_level_ancestor()
+    ///  これを呼ぶと jump が O(1) になる (ladder algorithm)
+    ///  最長の子を辿るパスに分解し, 各パスを長さ分だけ根方向に伸ばした梯子を持つ
+    ///  2^h 個上へのポインタで 2^h 上がると, そこを通る梯子で残り (< 2^h) を一度に上がれる
+    ///  O(n log n) time, O(n log n) memory
+    void build_level_ancestor() {
+        //  long_child[u] := 高さが最大の子
+        std::vector<int> long_child(n_, -1);
+        for (int u: tour_) {
+            for (const auto& e: (*this)[u]) {
+                if (e.to == parent_[u]) continue;
+                if (long_child[u] == -1 || height_[long_child[u]] < height_[e.to]) long_child[u] = e.to;
+            }
+        }
+        ladder_.clear();
+        ladder_.reserve(2 * n_);
+        ladder_index_.assign(n_, 0);
+        std::vector<int> path;
+        for (int top: tour_) {
+            if (top != root_ && long_child[parent_[top]] == top) continue;
+            path.clear();
+            for (int x = top; x != -1; x = long_child[x]) path.push_back(x);
+            //  下から順に並べ, 同じ長さだけ根方向に伸ばす
+            const int start = ladder_.size();
+            for (int i = std::ssize(path) - 1; i >= 0; i--) {
+                ladder_index_[path[i]] = ladder_.size();
+                ladder_.push_back(path[i]);
+            }
+            for (int x = parent_[top]; x != -1 && std::ssize(ladder_) - start < 2 * std::ssize(path); x = parent_[x]) {
+                ladder_.push_back(x);
+            }
+        }
+        //  ancestor_[h * n + x] := xから 2^h 個上 (根より上は根)
+        const int max_depth = *std::max_element(depth_.begin(), depth_.end());
+        const int levels = std::bit_width((unsigned)max_depth);
+        ancestor_.assign((long long)levels * n_, root_);
+        for (int x = 0; x < n_; x++) {
+            if (x != root_) ancestor_[x] = parent_[x];
+        }
+        for (int h = 1; h < levels; h++) {
+            const int* prev = ancestor_.data() + (long long)(h - 1) * n_;
+            int* next = ancestor_.data() + (long long)h * n_;
+            for (int x = 0; x < n_; x++) next[x] = prev[prev[x]];
+        }
+    }
+
     ///  # least common ancester
-    ///  O(log n)
+    ///  O(log n), build_lca_table() の後は O(1)
     int lca(int lhs, int rhs) {
         assert(0 <= lhs && lhs < n_);
         assert(0 <= rhs && rhs < n_);
+        if (!rmq_mask_.empty()) {
+            if (lhs == rhs) return lhs;
+            int l = std::min(in_[lhs], in_[rhs]) + 1;
+            int r = std::max(in_[lhs], in_[rhs]);
+            return parent_[tour_[range_argmin(l, r)]];
+        }
         while (head_[lhs] != head_[rhs]) {
             if (in_[lhs] > in_[rhs]) std::swap(lhs, rhs);
             rhs = parent_[head_[rhs]];
@@ -45,10 +166,21 @@ class Tree: public Graph<T> {
         return (depth_[lhs] < depth_[rhs] ? lhs : rhs);
     }
 
+    ///  # lca_batch(queries)
+    ///  queries[i] = (u, v) の lca をまとめて求める
+    ///  build_lca_table() を呼んでいなければ呼ぶ
+    ///  O(n + q)
+    std::vector<int> lca_batch(const std::vector<std::pair<int, int>>& queries) {
+        if (rmq_mask_.empty()) build_lca_table();
+        std::vector<int> result(queries.size());
+        for (int i = 0; i < std::ssize(queries); i++) result[i] = lca(queries[i].first, queries[i].second);
+        return result;
+    }
+
     ///  # dist(lhs, rhs)
     ///  distance from lhs to rhs (without weight)
     ///  num of edges of path
-    ///  O(log n)
+    ///  O(log n), build_lca_table() の後は O(1)
     int dist(int lhs, int rhs) {
         assert(0 <= lhs && lhs < n_);
         assert(0 <= rhs && rhs < n_);
@@ -58,7 +190,7 @@ class Tree: public Graph<T> {
     ///  # dist(lhs, rhs)
     ///  distance from lhs to rhs (with weight)
     ///  sum of edges weight of path
-    ///  O(log n)
+    ///  O(log n), build_lca_table() の後は O(1)
     T weighted_dist(int lhs, int rhs) {
         assert(0 <= lhs && lhs < n_);
         assert(0 <= rhs && rhs < n_);
@@ -69,10 +201,16 @@ class Tree: public Graph<T> {
     ///  level ancester
     ///  根方向にk回移動
     ///  移動できないと壊れる
-    ///  O(log n)
+    ///  O(log n), build_level_ancestor() の後は O(1)
     int jump(int x, int k) {
         assert(0 <= x && x < n_);
         assert(0 <= k && k <= depth_[x]);
+        if (!ladder_.empty()) {
+            if (k == 0) return x;
+            int h = std::bit_width((unsigned)k) - 1;
+            int y = ancestor_[(long long)h * n_ + x];
+            return ladder_[ladder_index_[y] + k - (1 << h)];
+        }
         while (k > depth_[x] - depth_[head_[x]]) {
             k -= depth_[x] - depth_[head_[x]] + 1;
             x = parent_[head_[x]];
@@ -85,7 +223,7 @@ class Tree: public Graph<T> {
     ///  jump on tree
     ///  fromからtoに向かってk回移動
     ///  移動できないと壊れる
-    ///  O(log n)
+    ///  O(log n), build_lca_table() と build_level_ancestor() の後は O(1)
     int jump(int from, int to, int k) {
         assert(0 <= from && from < n_);
         assert(0 <= to && to < n_);
@@ -164,46 +302,147 @@ class Tree: public Graph<T> {
     std::vector<int> head_;
     std::vector<int> parent_;
     std::vector<int> tour_;
+    //  relabel = true のときだけ持つ. label_[元の番号] = 新しい番号
+    std::vector<int> label_;
+    std::vector<int> original_;
+    //  build_lca_table() で作る. 行きがけ順の深さの区間最小
+    std::vector<unsigned long long> rmq_mask_;
+    std::vector<int> rmq_table_;
+    int rmq_blocks_ = 0;
+    //  build_level_ancestor() で作る
+    std::vector<int> ladder_;
+    std::vector<int> ladder_index_;
+    std::vector<int> ancestor_;
 
   private:
-    int set_heavy_edge(int u, int p) {
-        int size_sum = 1;
-        int max_size = 0;
-        int max_size_i = 0;
-        auto&& adj = (*this)[u];
-        for (int i = 0; i < std::ssize(adj); i++) {
-            const auto& e = adj[i];
-            if (e.to == p) continue;
-            int size = set_heavy_edge(e.to, u);
-            size_sum += size;
-            if (max_size < size) {
-                max_size = size;
-                max_size_i = i;
+    //  行きがけ順の位置のうち浅い方
+    int shallower(int i, int j) const {
+        return depth_[tour_[j]] < depth_[tour_[i]] ? j : i;
+    }
+
+    //  同じブロック内の [l, r] で深さが最小の位置
+    int block_argmin(int l, int r) const {
+        return l + std::countr_zero(rmq_mask_[r] >> (l % 64));
+    }
+
+    //  [l, r] で深さが最小の位置
+    int range_argmin(int l, int r) const {
+        constexpr int B = 64;
+        int lb = l / B, rb = r / B;
+        if (lb == rb) return block_argmin(l, r);
+        int result = shallower(block_argmin(l, lb * B + B - 1), block_argmin(rb * B, r));
+        if (lb + 1 < rb) {
+            int h = std::bit_width((unsigned)(rb - lb - 1)) - 1;
+            result = shallower(result, rmq_table_[(long long)h * rmq_blocks_ + lb + 1]);
+            result = shallower(result, rmq_table_[(long long)h * rmq_blocks_ + rb - (1 << h)]);
+        }
+        return result;
+    }
+
+    //  再帰せずに, 根からのBFS順に数回なめて作る
+    //  1. BFS順, 親, 深さ
+    //  2. 逆順に部分木の大きさ, 高さ. 一番大きい子を隣接リストの先頭に移す (heavy edge)
+    //  3. BFS順に, 子に行きがけ順の番号を部分木の大きさずつずらして振る
+    void build() {
+        std::vector<int> order;
+        order.reserve(n_);
+        order.push_back(root_);
+        //  parent_weight[u] := u と親を結ぶ辺の重み
+        std::vector<T> parent_weight(n_);
+        for (int i = 0; i < n_; i++) {
+            int u = order[i];
+            for (const auto& e: (*this)[u]) {
+                if (e.to == parent_[u]) continue;
+                parent_[e.to] = u;
+                parent_weight[e.to] = e.weight;
+                depth_[e.to] = depth_[u] + 1;
+                weighted_depth_[e.to] = weighted_depth_[u] + e.weight;
+                order.push_back(e.to);
+            }
+        }
+
+        std::vector<int> size(n_, 1);
+        for (int i = n_ - 1; i >= 0; i--) {
+            int u = order[i];
+            auto&& adj = (*this)[u];
+            int max_size = 0;
+            int max_size_i = 0;
+            for (int j = 0; j < std::ssize(adj); j++) {
+                const auto& e = adj[j];
+                if (e.to == parent_[u]) continue;
+                if (max_size < size[e.to]) {
+                    max_size = size[e.to];
+                    max_size_i = j;
+                }
+            }
+            if (max_size_i != 0) {
+                std::swap(adj[0], adj[max_size_i]);
+            }
+            int p = parent_[u];
+            if (p == -1) continue;
+            size[p] += size[u];
+            height_[p] = std::max(height_[p], height_[u] + 1);
+            weighted_height_[p] = std::max(weighted_height_[p], weighted_height_[u] + parent_weight[u]);
+        }
+
+        tour_.resize(n_);
+        in_[root_] = 0;
+        for (int u: order) {
+            tour_[in_[u]] = u;
+            out_[u] = in_[u] + size[u];
+            int now = in_[u] + 1;
+            bool heavy = true;
+            for (const auto& e: (*this)[u]) {
+                if (e.to == parent_[u]) continue;
+                head_[e.to] = (heavy ? head_[u] : e.to);
+                heavy = false;
+                in_[e.to] = now;
+                now += size[e.to];
+            }
+        }
+    }
+
+    //  行きがけ順の番号に付け替える
+    //  隣接リストは子を番号順 (heavy child が先頭), 最後に親の順に並べる
+    void relabel_vertices(const std::vector<EdgeBase<T>>& edges) {
+        label_ = in_;
+        original_ = tour_;
+        std::vector<EdgeBase<T>> relabeled = edges;
+        for (auto& e: relabeled) {
+            e.from = label_[e.from];
+            e.to = label_[e.to];
+        }
+        Graph<T>::operator=(to_undirected_graph(n_, relabeled));
+
+        auto permute = [&](auto& data) {
+            auto result = data;
+            for (int x = 0; x < n_; x++) result[label_[x]] = data[x];
+            data = std::move(result);
+        };
+        auto rename = [&](std::vector<int>& data) {
+            for (int& x: data) {
+                if (x != -1) x = label_[x];
             }
+        };
+        permute(weighted_depth_);
+        permute(weighted_height_);
+        permute(depth_);
+        permute(height_);
+        permute(out_);
+        permute(head_);
+        rename(head_);
+        permute(parent_);
+        rename(parent_);
+        for (int x = 0; x < n_; x++) in_[x] = tour_[x] = x;
+        root_ = 0;
+        for (int u = 0; u < n_; u++) {
+            auto&& adj = (*this)[u];
+            std::sort(adj.begin(), adj.end(), [&](const auto& lhs, const auto& rhs) {
+                int l = lhs.to == parent_[u] ? n_ : lhs.to;
+                int r = rhs.to == parent_[u] ? n_ : rhs.to;
+                return l < r;
+            });
         }
-        if (max_size_i != 0) {
-            std::swap(adj[0], adj[max_size_i]);
-        }
-        return size_sum;
-    }
-
-    int dfs(int u, int p, int now) {
-        tour_.push_back(u);
-        parent_[u] = p;
-        in_[u] = now++;
-        bool heavy = true;
-        for (const auto& e: (*this)[u]) {
-            if (e.to == p) continue;
-            head_[e.to] = (heavy ? head_[u] : e.to);
-            weighted_depth_[e.to] = weighted_depth_[u] + e.weight;
-            depth_[e.to] = depth_[u] + 1;
-            heavy = false;
-            now = dfs(e.to, u, now);
-            weighted_height_[u] = std::max(weighted_height_[u], weighted_height_[e.to] + e.weight);
-            height_[u] = std::max(height_[u], height_[e.to] + 1);
-        }
-        out_[u] = now;
-        return now;
     }
 };
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace nono {
+
+namespace internal {
+
+///  # parallel_for(size, threads, f)
+///  [0, size) を番号順に threads 個の区間に分け, id番目の区間 [left, right) について f(id, left, right) を呼ぶ
+///  id = 0 は呼び出し元で, それ以外は std::thread で実行し, 全て終わるまで待つ
+///  区間の分け方は size, threads だけで決まる
+template <class F>
+void parallel_for(int size, int threads, const F& f) {
+    assert(0 <= size);
+    assert(threads >= 1);
+    auto work = [&](int id) {
+        f(id, (int)((long long)size * id / threads), (int)((long long)size * (id + 1) / threads));
+    };
+    if (threads == 1) {
+        work(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int id = 1; id < threads; id++) workers.emplace_back(work, id);
+    work(0);
+    for (auto& worker: workers) worker.join();
+}
+
+}  //  namespace internal
+
+}  //  namespace nono
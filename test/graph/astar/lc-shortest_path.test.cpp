@@ -0,0 +1,41 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/shortest_path"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/astar.hpp"
+#include "../../../nono/graph/base.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m, s, t;
+    std::cin >> n >> m >> s >> t;
+    std::vector<WeightedEdge<long long>> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        long long w;
+        std::cin >> u >> v >> w;
+        edges.emplace_back(u, v, w);
+    }
+    auto graph = to_directed_graph(n, edges);
+    //  自明な下界しかないので heuristic = 0
+    auto result = astar(graph, s, t, [](int) { return 0LL; });
+    if (result.invalid()) {
+        std::cout << -1 << '\n';
+        return;
+    }
+    auto path = result.path();
+    int length = path.size();
+    std::cout << result.dist() << ' ' << length - 1 << '\n';
+    for (int i = 0; i + 1 < length; i++) {
+        std::cout << path[i] << ' ' << path[i + 1] << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
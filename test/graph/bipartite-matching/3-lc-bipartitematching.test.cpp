@@ -0,0 +1,29 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/bipartitematching"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/graph/bipartite-matching.hpp"
+
+namespace nono {
+
+void solve() {
+    int l, r, m;
+    std::cin >> l >> r >> m;
+    std::vector<std::pair<int, int>> edges(m);
+    for (auto& [u, v]: edges) std::cin >> u >> v;
+    //  半分ずつ追加して, その都度増加させる
+    BipartiteMatcher matcher(l, r);
+    for (int i = 0; i < m / 2; i++) matcher.add_edge(edges[i].first, edges[i].second);
+    matcher.solve();
+    for (int i = m / 2; i < m; i++) matcher.add_edge(edges[i].first, edges[i].second);
+    std::cout << matcher.solve() << '\n';
+    for (auto i: matcher.matching()) std::cout << edges[i].first << ' ' << edges[i].second << '\n';
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
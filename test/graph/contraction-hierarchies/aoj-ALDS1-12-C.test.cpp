@@ -0,0 +1,40 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/lesson/1/ALDS1/12/ALDS1_12_C"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/contraction-hierarchies.hpp"
+
+namespace nono {
+
+void solve() {
+    int n;
+    std::cin >> n;
+    std::vector<WeightedEdge<int>> edges;
+    for (int i = 0; i < n; i++) {
+        int u, k;
+        std::cin >> u >> k;
+        for (int j = 0; j < k; j++) {
+            int v, c;
+            std::cin >> v >> c;
+            edges.emplace_back(u, v, c);
+        }
+    }
+    ContractionHierarchies<int> built(to_directed_graph(n, edges));
+    //  書き出して読み直したものでクエリを処理する
+    std::stringstream buffer;
+    buffer << built;
+    ContractionHierarchies<int> ch;
+    buffer >> ch;
+    for (int i = 0; i < n; i++) {
+        std::cout << i << ' ' << ch.dist(0, i) << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,38 @@
+#define PROBLEM "https://atcoder.jp/contests/dp/tasks/dp_g"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/dag-path.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m;
+    std::cin >> n >> m;
+    std::vector<Edge> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; i++) {
+        int x, y;
+        std::cin >> x >> y;
+        x--;
+        y--;
+        edges.emplace_back(x, y);
+    }
+    const auto graph = to_directed_graph(n, edges);
+    std::vector<int> source(n);
+    std::iota(source.begin(), source.end(), 0);
+    auto result = dag_longest_path(graph, source, 2);
+    int answer = 0;
+    for (int i = 0; i < n; i++) answer = std::max(answer, result.dist(i));
+    std::cout << answer << '\n';
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,39 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/lesson/1/ALDS1/11/ALDS1_11_C"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/direction-optimizing-bfs.hpp"
+
+namespace nono {
+
+void solve() {
+    int n;
+    std::cin >> n;
+    std::vector<Edge> edges, reverse_edges;
+    for (int i = 0; i < n; i++) {
+        int u, k;
+        std::cin >> u >> k;
+        u--;
+        for (int j = 0; j < k; j++) {
+            int v;
+            std::cin >> v;
+            v--;
+            edges.emplace_back(u, v);
+            reverse_edges.emplace_back(v, u);
+        }
+    }
+    auto graph = to_directed_graph(n, edges);
+    auto reverse_graph = to_directed_graph(n, reverse_edges);
+    auto result = direction_optimizing_bfs(graph, reverse_graph, 0);
+    for (int i = 0; i < n; i++) {
+        std::cout << i + 1 << ' ' << (result.invalid(i) ? -1 : result.dist(i)) << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
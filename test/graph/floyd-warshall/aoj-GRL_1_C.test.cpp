@@ -0,0 +1,45 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/1/GRL_1_C"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/floyd-warshall.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m;
+    std::cin >> n >> m;
+    std::vector<WeightedEdge<long long>> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        long long w;
+        std::cin >> u >> v >> w;
+        edges.emplace_back(u, v, w);
+    }
+    auto result = floyd_warshall(n, edges);
+
+    if (result.has_negative_cycle()) {
+        std::cout << "NEGATIVE CYCLE" << '\n';
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (j) std::cout << ' ';
+            if (result.invalid(i, j)) {
+                std::cout << "INF";
+            } else {
+                std::cout << result.dist(i, j);
+            }
+        }
+        std::cout << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,38 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/biconnected_components"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/lowlink.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m;
+    std::cin >> n >> m;
+    std::vector<Edge> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        edges.emplace_back(u, v);
+    }
+    const auto graph = to_undirected_graph(n, edges);
+    const auto result = lowlink(graph);
+    const auto& groups = result.biconnected_components();
+    std::cout << groups.size() << '\n';
+    for (int i = 0; i < groups.size(); i++) {
+        std::cout << groups[i].size();
+        for (auto v: groups[i]) {
+            std::cout << ' ' << v;
+        }
+        std::cout << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,25 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/6/GRL_6_A"
+#include <iostream>
+
+#include "../../../nono/graph/max-flow.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m;
+    std::cin >> n >> m;
+    MaxFlow<int> graph(n);
+    for (int i = 0; i < m; i++) {
+        int u, v, c;
+        std::cin >> u >> v >> c;
+        graph.add_edge(u, v, c);
+    }
+    std::cout << graph.push_relabel(0, n - 1) << '\n';
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
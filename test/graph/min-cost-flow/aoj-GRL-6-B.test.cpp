@@ -0,0 +1,30 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/6/GRL_6_B"
+#include <iostream>
+
+#include "../../../nono/graph/min-cost-flow.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m, f;
+    std::cin >> n >> m >> f;
+    MinCostFlow<int> graph(n);
+    for (int i = 0; i < m; i++) {
+        int u, v, c, d;
+        std::cin >> u >> v >> c >> d;
+        graph.add_edge(u, v, c, d);
+    }
+    auto [flow, cost] = graph.flow(0, n - 1, f);
+    if (flow < f) {
+        std::cout << -1 << '\n';
+    } else {
+        std::cout << cost << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
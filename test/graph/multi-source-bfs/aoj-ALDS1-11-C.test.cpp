@@ -0,0 +1,53 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/lesson/1/ALDS1/11/ALDS1_11_C"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/graph/bfs.hpp"
+#include "../../../nono/graph/multi-source-bfs.hpp"
+
+namespace nono {
+
+void solve() {
+    int n;
+    std::cin >> n;
+    std::vector<Edge> edges;
+    for (int i = 0; i < n; i++) {
+        int u, k;
+        std::cin >> u >> k;
+        u--;
+        for (int j = 0; j < k; j++) {
+            int v;
+            std::cin >> v;
+            v--;
+            edges.emplace_back(u, v);
+        }
+    }
+    auto graph = to_directed_graph(n, edges);
+    //  全ての頂点を逆順に3回並べた始点で求め, 全ての始点 (64本ずつの全てのbatch, 全てのbit) を
+    //  頂点ごとのbfsと比べてから, 頂点0からの距離を出力する
+    std::vector<int> source;
+    for (int t = 0; t < 3; t++) {
+        for (int v = n - 1; v >= 0; v--) source.push_back(v);
+    }
+    auto result = multi_source_bfs(graph, source);
+    for (int i = 0; i < std::ssize(source); i++) {
+        auto expected = bfs(graph, source[i]);
+        for (int v = 0; v < n; v++) {
+            assert(result.invalid(i, v) == expected.invalid(v));
+            if (!expected.invalid(v)) assert(result.dist(i, v) == expected.dist(v));
+        }
+    }
+    const int zero = std::ssize(source) - 1;
+    for (int i = 0; i < n; i++) {
+        std::cout << i + 1 << ' ' << (result.invalid(zero, i) ? -1 : result.dist(zero, i)) << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
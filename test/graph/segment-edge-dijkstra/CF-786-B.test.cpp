@@ -0,0 +1,50 @@
+#define IGNORE
+#define PROBLEM "https://codeforces.com/contest/786/problem/B"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/graph/segment-edge-dijkstra.hpp"
+#include "../../../nono/graph/segment-edge.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, q, s;
+    std::cin >> n >> q >> s;
+    s--;
+    std::vector<SegmentEdge<long long>> edges;
+    edges.reserve(q);
+    for (int i = 0; i < q; i++) {
+        int type;
+        std::cin >> type;
+        if (type == 1) {
+            int v, u;
+            long long w;
+            std::cin >> v >> u >> w;
+            v--, u--;
+            edges.emplace_back(std::pair(v, v + 1), std::pair(u, u + 1), w);
+        } else {
+            int v, l, r;
+            long long w;
+            std::cin >> v >> l >> r >> w;
+            v--, l--;
+            if (type == 2) {
+                edges.emplace_back(std::pair(v, v + 1), std::pair(l, r), w);
+            } else {
+                edges.emplace_back(std::pair(l, r), std::pair(v, v + 1), w);
+            }
+        }
+    }
+    auto result = segment_edge_dijkstra(n, edges, s);
+    for (int v = 0; v < n; v++) {
+        std::cout << (result.invalid(v) ? -1 : result.dist(v)) << (v + 1 == n ? '\n' : ' ');
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,40 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/shortest_path"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/graph/segment-edge-dijkstra.hpp"
+#include "../../../nono/graph/segment-edge.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, m, s, t;
+    std::cin >> n >> m >> s >> t;
+    std::vector<SegmentEdge<long long>> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        long long w;
+        std::cin >> u >> v >> w;
+        edges.emplace_back(std::pair(u, u + 1), std::pair(v, v + 1), w);
+    }
+    auto result = segment_edge_dijkstra(n, edges, s);
+    if (result.invalid(t)) {
+        std::cout << -1 << '\n';
+        return;
+    }
+    auto path = result.path(t);
+    int length = path.size();
+    std::cout << result.dist(t) << ' ' << length - 1 << '\n';
+    for (int i = 0; i + 1 < length; i++) {
+        std::cout << path[i] << ' ' << path[i + 1] << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,50 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/1/GRL_1_C"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/math/min-plus-product.hpp"
+
+namespace nono {
+
+//  隣接行列を二乗していけば, 辺の本数が n 以上の路まで見た全点対最短路になる
+//  負閉路があれば, どこかの頂点から自分への距離が負になる
+void solve() {
+    constexpr long long INF = internal::MIN_PLUS_INF<long long>;
+    int n, m;
+    std::cin >> n >> m;
+    std::vector<long long> dist((long long)n * n, INF);
+    for (int v = 0; v < n; v++) dist[(long long)v * n + v] = 0;
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        long long w;
+        std::cin >> u >> v >> w;
+        dist[(long long)u * n + v] = std::min(dist[(long long)u * n + v], w);
+    }
+    for (int length = 1; length < n; length *= 2) dist = min_plus_product(dist, dist, n, n, n, 2);
+
+    for (int v = 0; v < n; v++) {
+        if (dist[(long long)v * n + v] < 0) {
+            std::cout << "NEGATIVE CYCLE" << '\n';
+            return;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (j) std::cout << ' ';
+            if (dist[(long long)i * n + j] >= INF) {
+                std::cout << "INF";
+            } else {
+                std::cout << dist[(long long)i * n + j];
+            }
+        }
+        std::cout << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
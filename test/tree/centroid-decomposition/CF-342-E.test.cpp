@@ -0,0 +1,58 @@
+#define IGNORE
+#define PROBLEM "https://codeforces.com/contest/342/problem/E"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/tree/centroid-decomposition.hpp"
+
+namespace nono {
+
+void solve() {
+    constexpr int INF = 1 << 30;
+    int n, m;
+    std::cin >> n >> m;
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 0; i + 1 < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        u--;
+        v--;
+        edges.emplace_back(u, v);
+    }
+    CentroidDecomposition decomposition(to_undirected_graph(n, edges));
+    //  nearest[c] := cの成分にある赤い頂点までのcからの距離の最小
+    std::vector<int> nearest(n, INF);
+    auto paint = [&](int v) {
+        for (int k = 0; k <= decomposition.depth(v); k++) {
+            int c = decomposition.ancestor(v, k);
+            nearest[c] = std::min(nearest[c], decomposition.dist(v, k));
+        }
+    };
+    paint(0);
+    while (m--) {
+        int t, v;
+        std::cin >> t >> v;
+        v--;
+        if (t == 1) {
+            paint(v);
+        } else {
+            int result = INF;
+            for (int k = 0; k <= decomposition.depth(v); k++) {
+                int c = decomposition.ancestor(v, k);
+                result = std::min(result, nearest[c] + decomposition.dist(v, k));
+            }
+            std::cout << result << '\n';
+        }
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,85 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/vertex_add_range_contour_sum_on_tree"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/ds/fenwick-tree.hpp"
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/tree/centroid-decomposition.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, q;
+    std::cin >> n >> q;
+    std::vector<long long> a(n);
+    for (auto& x: a) std::cin >> x;
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 0; i + 1 < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        edges.emplace_back(u, v);
+    }
+    CentroidDecomposition decomposition(to_undirected_graph(n, edges));
+    //  size[c] := 重心cの成分の頂点数
+    std::vector<int> size(n);
+    for (int v = 0; v < n; v++) {
+        for (int k = 0; k <= decomposition.depth(v); k++) size[decomposition.ancestor(v, k)]++;
+    }
+    //  inner[c] := cの成分の頂点を c からの距離ごとに足したもの
+    //  outer[c] := cの成分の頂点を 重心木での親 からの距離ごとに足したもの. 親の側で二重に数えた分を引く
+    std::vector<FenwickTree<long long>> inner, outer;
+    inner.reserve(n);
+    outer.reserve(n);
+    for (int c = 0; c < n; c++) {
+        inner.emplace_back(size[c]);
+        outer.emplace_back(size[c] + 1);
+    }
+    auto add = [&](int v, long long x) {
+        for (int k = 0; k <= decomposition.depth(v); k++) {
+            inner[decomposition.ancestor(v, k)].add(decomposition.dist(v, k), x);
+            if (k > 0) outer[decomposition.ancestor(v, k)].add(decomposition.dist(v, k - 1), x);
+        }
+    };
+    //  fenwickの [l, r) の和. 範囲外は切り詰める
+    auto range_sum = [](const FenwickTree<long long>& fenwick, int size, int l, int r) -> long long {
+        l = std::clamp(l, 0, size);
+        r = std::clamp(r, 0, size);
+        return l < r ? fenwick.sum(l, r) : 0;
+    };
+    for (int v = 0; v < n; v++) add(v, a[v]);
+
+    while (q--) {
+        int t;
+        std::cin >> t;
+        if (t == 0) {
+            int p;
+            long long x;
+            std::cin >> p >> x;
+            add(p, x);
+        } else {
+            int p, l, r;
+            std::cin >> p >> l >> r;
+            long long result = 0;
+            for (int k = 0; k <= decomposition.depth(p); k++) {
+                const int c = decomposition.ancestor(p, k);
+                const int d = decomposition.dist(p, k);
+                result += range_sum(inner[c], size[c], l - d, r - d);
+                if (k < decomposition.depth(p)) {
+                    const int child = decomposition.ancestor(p, k + 1);
+                    result -= range_sum(outer[child], size[child] + 1, l - d, r - d);
+                }
+            }
+            std::cout << result << '\n';
+        }
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
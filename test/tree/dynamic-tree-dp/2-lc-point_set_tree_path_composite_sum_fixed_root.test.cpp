@@ -0,0 +1,96 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/point_set_tree_path_composite_sum_fixed_root"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/math/modint.hpp"
+#include "../../../nono/tree/dynamic-tree-dp.hpp"
+
+namespace nono {
+
+using Mint = Modint998244353;
+struct Info {
+    struct Point {
+        Point(): sum(0), num(0) {}
+        Point(Mint sum, Mint num = 1): sum(sum), num(num) {}
+        Mint sum;
+        Mint num;
+    };
+    struct Edge {
+        Edge(Mint a = 1, Mint b = 0): a(a), b(b) {}
+        Mint a;
+        Mint b;
+    };
+    struct Path {
+        Point point{};
+        Edge edge{};
+    };
+    //  light edge をつける作業
+    static Point add_edge(Edge edge, Point point) {
+        return {edge.a * point.sum + edge.b * point.num, point.num};
+    }
+    static Path add_vertex(Point real, Point vir) {
+        return {Point{real.sum + vir.sum, real.num + vir.num}, Edge{}};
+    }
+    static Path vertex(Point point) {
+        return {point, Edge{}};
+    }
+    //  rhs <- (mhs) <- lhs <- ... root
+    static Path compress(Path lhs, Edge mhs, Path rhs) {
+        Edge edge{lhs.edge.a * mhs.a, lhs.edge.a * mhs.b + lhs.edge.b};
+        Point point{lhs.point.sum + edge.a * rhs.point.sum + edge.b * rhs.point.num, lhs.point.num + rhs.point.num};
+        return {point, Edge{edge.a * rhs.edge.a, edge.a * rhs.edge.b + edge.b}};
+    }
+    static Point rake(Point lhs, Point rhs) {
+        return {lhs.sum + rhs.sum, lhs.num + rhs.num};
+    }
+};
+
+void solve() {
+    using Point = Info::Point;
+    using Edge = Info::Edge;
+    int n, q;
+    std::cin >> n >> q;
+    //  初期値は空の木から一度の set_batch で全て書き込む
+    std::vector<std::pair<int, Point>> a(n);
+    for (int i = 0; i < n; i++) {
+        Mint x;
+        std::cin >> x;
+        a[i] = {i, Point{x, 1}};
+    }
+    std::vector<EdgeBase<int>> edges;
+    std::vector<std::pair<int, Edge>> w;
+    for (int i = 0; i < n - 1; i++) {
+        int u, v;
+        Mint a, b;
+        std::cin >> u >> v >> a >> b;
+        edges.emplace_back(u, v);
+        w.emplace_back(i, Edge{a, b});
+    }
+    DynamicTreeDP<Info> tree(n, edges, std::vector<Point>(n), std::vector<Edge>(n - 1), 0, 2);
+    tree.set_batch(a, w, 2);
+    while (q--) {
+        int t;
+        std::cin >> t;
+        if (t == 0) {
+            int u;
+            Mint x;
+            std::cin >> u >> x;
+            tree.set_batch({{u, Point{x, 1}}}, {}, 2);
+        } else {
+            int i;
+            Mint x, y;
+            std::cin >> i >> x >> y;
+            tree.set_batch({}, {{i, Edge{x, y}}}, 2);
+        }
+        std::cout << tree.all_prod().sum << '\n';
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
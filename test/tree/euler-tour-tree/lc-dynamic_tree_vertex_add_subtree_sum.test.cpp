@@ -0,0 +1,47 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/dynamic_tree_vertex_add_subtree_sum"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/structure/monoid.hpp"
+#include "../../../nono/tree/euler-tour-tree.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, q;
+    std::cin >> n >> q;
+    std::vector<long long> a(n);
+    for (int i = 0; i < n; i++) std::cin >> a[i];
+    EulerTourTree<monoid::Add<long long>> tree(a);
+    for (int i = 0; i + 1 < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        tree.link(u, v);
+    }
+    while (q--) {
+        int t;
+        std::cin >> t;
+        if (t == 0) {
+            int u, v, w, x;
+            std::cin >> u >> v >> w >> x;
+            tree.cut(u, v);
+            tree.link(w, x);
+        } else if (t == 1) {
+            int p;
+            long long x;
+            std::cin >> p >> x;
+            tree.set(p, tree.get(p) + x);
+        } else {
+            int v, p;
+            std::cin >> v >> p;
+            std::cout << tree.subtree_prod(v, p) << '\n';
+        }
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
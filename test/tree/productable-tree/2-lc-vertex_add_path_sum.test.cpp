@@ -0,0 +1,46 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/vertex_add_path_sum"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/structure/act-monoid.hpp"
+#include "../../../nono/structure/monoid.hpp"
+#include "../../../nono/tree/productable-tree.hpp"
+
+namespace nono {
+
+void solve() {
+    using Monoid = act_monoid::ActMonoid<monoid::Add<long long>>;
+    int n, q;
+    std::cin >> n >> q;
+    std::vector<long long> a(n);
+    for (int i = 0; i < n; i++) std::cin >> a[i];
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 1; i < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        edges.emplace_back(u, v);
+    }
+    ProductableTree<Monoid, int> tree(n, edges, a, 0, true);
+    while (q--) {
+        int t;
+        std::cin >> t;
+        if (t == 0) {
+            int p;
+            long long x;
+            std::cin >> p >> x;
+            tree.set(tree.label(p), a[p] += x);
+        } else {
+            int u, v;
+            std::cin >> u >> v;
+            std::cout << tree.prod_path(tree.label(u), tree.label(v)) << '\n';
+        }
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,92 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/problems/2450"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/tree/productable-tree.hpp"
+
+namespace nono {
+
+//  パス上の空でない連続部分列の和の最大値. 作用は区間の代入 (可換でない)
+struct PathAssignMaxSubSeq {
+    static constexpr long long NEG_INF = std::numeric_limits<long long>::min() / 4;
+    struct Value {
+        long long sum = 0;
+        long long best = NEG_INF;
+        long long prefix = NEG_INF;
+        long long suffix = NEG_INF;
+        int size = 0;
+    };
+    using Act = std::optional<long long>;
+    static Value op(const Value& lhs, const Value& rhs) {
+        if (lhs.size == 0) return rhs;
+        if (rhs.size == 0) return lhs;
+        return Value{lhs.sum + rhs.sum, std::max({lhs.best, rhs.best, lhs.suffix + rhs.prefix}),
+                     std::max(lhs.prefix, lhs.sum + rhs.prefix), std::max(rhs.suffix, rhs.sum + lhs.suffix),
+                     lhs.size + rhs.size};
+    }
+    static Value e() {
+        return Value{};
+    }
+    static Value mapping(Act act, Value value) {
+        if (!act || value.size == 0) return value;
+        const long long sum = *act * value.size;
+        const long long best = *act > 0 ? sum : *act;
+        return Value{sum, best, best, best, value.size};
+    }
+    static Act composition(Act lhs, Act rhs) {
+        return lhs ? lhs : rhs;
+    }
+    static Act id() {
+        return std::nullopt;
+    }
+};
+
+void solve() {
+    using Monoid = PathAssignMaxSubSeq;
+    using Value = Monoid::Value;
+    int n, q;
+    std::cin >> n >> q;
+    std::vector<Value> a(n);
+    for (int i = 0; i < n; i++) {
+        long long w;
+        std::cin >> w;
+        a[i] = Value{w, w, w, w, 1};
+    }
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 1; i < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        edges.emplace_back(u - 1, v - 1);
+    }
+    ProductableTree<Monoid, int> tree(n, edges, a);
+    //  次のクエリまでの代入をまとめて作用させる. 重なるパスへの代入は順番が効く
+    std::vector<std::pair<int, int>> paths;
+    std::vector<Monoid::Act> acts;
+    while (q--) {
+        int t, u, v;
+        long long c;
+        std::cin >> t >> u >> v >> c;
+        u--, v--;
+        if (t == 1) {
+            paths.emplace_back(u, v);
+            acts.emplace_back(c);
+        } else {
+            tree.apply_path_batch(paths, acts);
+            paths.clear();
+            acts.clear();
+            std::cout << tree.prod_path(u, v).best << '\n';
+        }
+    }
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
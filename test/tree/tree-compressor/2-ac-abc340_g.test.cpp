@@ -0,0 +1,64 @@
+#define IGNORE
+#define PROBLEM "https://atcoder.jp/contests/abc340/tasks/abc340_g"
+#include <iostream>
+#include <vector>
+
+#include "../../../nono/graph/base.hpp"
+#include "../../../nono/math/modint.hpp"
+#include "../../../nono/tree/tree-compressor.hpp"
+
+namespace nono {
+
+void solve() {
+    using Mint = nono::Modint998244353;
+    int n;
+    std::cin >> n;
+    std::vector<int> a(n);
+    for (int i = 0; i < n; i++) std::cin >> a[i];
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 0; i + 1 < n; i++) {
+        int u, v;
+        std::cin >> u >> v;
+        u--;
+        v--;
+        edges.emplace_back(u, v);
+    }
+    TreeCompressor tree_compressor(to_undirected_graph(n, edges));
+    std::vector divide_by_color(n, std::vector<int>());
+    for (int i = 0; i < n; i++) {
+        a[i]--;
+        divide_by_color[a[i]].push_back(i);
+    }
+    Mint ans = 0;
+    //  product[i] := 子の (dp + 1) の積, sum[i] := 子の dp の和
+    std::vector<Mint> product(n), sum(n);
+    for (int c = 0; c < n; c++) {
+        if (divide_by_color[c].empty()) continue;
+        auto view = tree_compressor.compress_view(divide_by_color[c]);
+        int m = view.size();
+        for (int i = 0; i < m; i++) product[i] = 1, sum[i] = 0;
+        //  子は親より後ろにあるので, 後ろから回せば葉から順になる
+        for (int i = m - 1; i >= 0; i--) {
+            Mint dp = product[i];
+            if (a[view.mapping[i]] != c) {
+                dp -= 1 + sum[i];
+                ans += dp;
+                dp += sum[i];
+            } else {
+                ans += dp;
+            }
+            if (i == 0) continue;
+            product[view.parent[i]] *= dp + 1;
+            sum[view.parent[i]] += dp;
+        }
+    }
+    std::cout << ans << '\n';
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}
@@ -0,0 +1,31 @@
+#define PROBLEM "https://judge.yosupo.jp/problem/lca"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../../../nono/tree/tree.hpp"
+
+namespace nono {
+
+void solve() {
+    int n, q;
+    std::cin >> n >> q;
+    std::vector<Edge> edges;
+    edges.reserve(n - 1);
+    for (int i = 1; i < n; i++) {
+        int p;
+        std::cin >> p;
+        edges.emplace_back(i, p);
+    }
+    Tree tree(n, edges);
+    std::vector<std::pair<int, int>> queries(q);
+    for (auto& [u, v]: queries) std::cin >> u >> v;
+    for (int w: tree.lca_batch(queries)) std::cout << w << '\n';
+}
+
+}  //  namespace nono
+
+int main() {
+    std::cin.tie(0)->sync_with_stdio(0);
+    nono::solve();
+}